@@ -0,0 +1,314 @@
+/**
+ * @file async_queue.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A queue whose push and pop are C++20 co_await-able. #NOTE This only works on C++20 standard.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_ASYNC_QUEUE_HPP
+#define CYBERTRON_BASE_ASYNC_QUEUE_HPP
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <mutex>
+#include <deque>
+#include <utility>
+#include <iostream>
+#include <exception>
+#include <optional>
+#include <coroutine>
+
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief Resumes coroutines right away on the thread that made them runnable. Mostly useful for tests and for
+ * single-threaded event loops.
+ *
+ */
+struct InlineExecutor {
+    void post(std::coroutine_handle<> handle) { handle.resume(); }
+};
+
+template <typename T, typename Executor, typename LockPolicy = StdLockPolicy>
+/**
+ * @brief The coroutine sibling of BlockingQueue. Instead of parking an OS thread in a condition variable, a coroutine
+ * that cannot proceed is suspended and queued inside AsyncQueue; whoever makes room or data available hands it over
+ * and resumes the coroutine on {Executor}, which must provide void post(std::coroutine_handle<>).
+ *
+ *      std::optional<Request> request = co_await queue.pop();   // std::nullopt once closed
+ *      bool pushed = co_await queue.push(std::move(reply));      // false once closed
+ *
+ * Waiters are served in FIFO order and a value for a waiting consumer is moved straight into its frame.
+ * #NOTE As with BlockingQueue, {capacity_limit} 0 means unbounded.
+ * #NOTE The destructor does not resume anyone: close() the queue, or drain it, before it is destroyed. Destroying it
+ * while a coroutine is still suspended in it would leave that frame pointing into freed memory, so the destructor
+ * calls std::terminate() instead, in release builds as well.
+ */
+class AsyncQueue : public Noncopyable {
+public:
+    using mutex_type = typename LockPolicy::mutex_type;
+
+    class PopAwaiter;
+    class PushAwaiter;
+
+    explicit AsyncQueue(Executor& executor, size_t capacity_limit = 0)
+        : _executor(executor),
+          _capacity_limit(capacity_limit),
+          _active(true),
+          _mutex(),
+          _dequeue(),
+          _poppers(),
+          _pushers() {}
+
+    // Resuming waiters from here would run them against a queue that is being torn down, so none may be left.
+    ~AsyncQueue() {
+        if (_poppers.head || _pushers.head) {
+            std::cerr << "Fatal! AsyncQueue destroyed with suspended coroutines, close() or drain it first."
+                      << std::endl;
+            std::terminate();
+        }
+    }
+
+    /**
+     * @brief Close the queue, drop all elements and resume every suspended coroutine with a failure result.
+     *
+     */
+    void close() {
+        WaiterList<PopAwaiter> poppers;
+        WaiterList<PushAwaiter> pushers;
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _active = false;
+            _dequeue.clear();
+            std::swap(poppers, _poppers);
+            std::swap(pushers, _pushers);
+        }
+        while (PopAwaiter* popper = poppers.pop()) {
+            _executor.post(popper->_handle);
+        }
+        while (PushAwaiter* pusher = pushers.pop()) {
+            pusher->_pushed = false;
+            _executor.post(pusher->_handle);
+        }
+    }
+
+    /**
+     * @brief co_await the result to pop the front element, suspending while the queue is empty.
+     *
+     * @return an awaitable yielding std::optional<T>, empty once the queue is closed.
+     */
+    PopAwaiter pop() { return PopAwaiter(*this); }
+
+    /**
+     * @brief co_await the result to push {element} to the back, suspending while the queue is full.
+     *
+     * @return an awaitable yielding true if the element was pushed, false once the queue is closed.
+     */
+    PushAwaiter push(T element) { return PushAwaiter(*this, std::move(element)); }
+
+    /**
+     * @brief Pop the front element without suspending, usable from plain threads as well.
+     *
+     * @return true if one element was popped, false if the queue is empty or closed.
+     */
+    bool try_pop(T& element) {
+        PushAwaiter* pusher = nullptr;
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            if ((!_active) || _dequeue.empty()) {
+                return false;
+            }
+            element = std::move(_dequeue.front());
+            _dequeue.pop_front();
+            pusher = _admit_pusher();
+        }
+        if (pusher) {
+            _executor.post(pusher->_handle);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Push {element} to the back without suspending, usable from plain threads as well.
+     *
+     * @return true if the element was pushed, false if the queue is full or closed.
+     */
+    bool try_push(T element) {
+        PopAwaiter* popper = nullptr;
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            if ((!_active) || (_pushers.head) || (_capacity_limit && _dequeue.size() >= _capacity_limit)) {
+                return false;
+            }
+            popper = _poppers.pop();
+            if (popper) {
+                popper->_element.emplace(std::move(element));
+            } else {
+                _dequeue.push_back(std::move(element));
+            }
+        }
+        if (popper) {
+            _executor.post(popper->_handle);
+        }
+        return true;
+    }
+
+    size_t size() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _dequeue.size();
+    }
+
+    size_t capacity() { return _capacity_limit; }
+
+    /**
+     * @brief Awaitable returned by pop(). Lives in the awaiting coroutine's frame, which is where the queue links it
+     * while the coroutine is suspended.
+     *
+     */
+    class PopAwaiter {
+    public:
+        explicit PopAwaiter(AsyncQueue& queue) : _queue(queue), _element(), _handle(), _next(nullptr) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            PushAwaiter* pusher = nullptr;
+            {
+                std::lock_guard<mutex_type> lock(_queue._mutex);
+                if (_queue._active && _queue._dequeue.empty()) {
+                    _handle = handle;
+                    _queue._poppers.push(this);
+                    return true;
+                }
+                if (_queue._active) {
+                    _element.emplace(std::move(_queue._dequeue.front()));
+                    _queue._dequeue.pop_front();
+                    pusher = _queue._admit_pusher();
+                }
+            }
+            if (pusher) {
+                _queue._executor.post(pusher->_handle);
+            }
+            return false;
+        }
+
+        std::optional<T> await_resume() { return std::move(_element); }
+
+    private:
+        friend class AsyncQueue;
+
+        AsyncQueue& _queue;
+        std::optional<T> _element;
+        std::coroutine_handle<> _handle;
+        PopAwaiter* _next;
+    };
+
+    /**
+     * @brief Awaitable returned by push(). Holds the element until it is handed to the queue or to a consumer.
+     *
+     */
+    class PushAwaiter {
+    public:
+        PushAwaiter(AsyncQueue& queue, T&& element)
+            : _queue(queue), _element(std::move(element)), _pushed(true), _handle(), _next(nullptr) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            PopAwaiter* popper = nullptr;
+            {
+                std::lock_guard<mutex_type> lock(_queue._mutex);
+                if (!_queue._active) {
+                    _pushed = false;
+                    return false;
+                }
+                popper = _queue._poppers.pop();
+                if (popper) {
+                    popper->_element.emplace(std::move(_element));
+                } else if ((!_queue._pushers.head) &&
+                           ((!_queue._capacity_limit) || _queue._dequeue.size() < _queue._capacity_limit)) {
+                    _queue._dequeue.push_back(std::move(_element));
+                } else {
+                    _handle = handle;
+                    _queue._pushers.push(this);
+                    return true;
+                }
+            }
+            if (popper) {
+                _queue._executor.post(popper->_handle);
+            }
+            return false;
+        }
+
+        bool await_resume() const noexcept { return _pushed; }
+
+    private:
+        friend class AsyncQueue;
+
+        AsyncQueue& _queue;
+        T _element;
+        bool _pushed;
+        std::coroutine_handle<> _handle;
+        PushAwaiter* _next;
+    };
+
+private:
+    template <typename Awaiter>
+    struct WaiterList {
+        Awaiter* head = nullptr;
+        Awaiter* tail = nullptr;
+
+        void push(Awaiter* awaiter) {
+            awaiter->_next = nullptr;
+            if (tail) {
+                tail->_next = awaiter;
+            } else {
+                head = awaiter;
+            }
+            tail = awaiter;
+        }
+
+        Awaiter* pop() {
+            Awaiter* awaiter = head;
+            if (awaiter) {
+                head = awaiter->_next;
+                if (!head) {
+                    tail = nullptr;
+                }
+            }
+            return awaiter;
+        }
+    };
+
+    // Must hold _mutex, right after an element left the buffer. Moves the oldest suspended pusher's element into the
+    // freed slot and returns it so the caller can resume it once the lock is released.
+    PushAwaiter* _admit_pusher() {
+        PushAwaiter* pusher = _pushers.pop();
+        if (pusher) {
+            _dequeue.push_back(std::move(pusher->_element));
+        }
+        return pusher;
+    }
+
+private:
+    Executor& _executor;
+    const size_t _capacity_limit;
+    bool _active;                      // guarded by _mutex
+    mutex_type _mutex;
+    std::deque<T> _dequeue;            // guarded by _mutex
+    WaiterList<PopAwaiter> _poppers;   // guarded by _mutex
+    WaiterList<PushAwaiter> _pushers;  // guarded by _mutex
+};
+
+}  // namespace cybertron::base
+
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#endif  // CYBERTRON_BASE_ASYNC_QUEUE_HPP
@@ -0,0 +1,196 @@
+/**
+ * @file blocking_priority_queue.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A blocking queue that pops the highest-priority element first.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_BLOCKING_PRIORITY_QUEUE_HPP
+#define CYBERTRON_BASE_BLOCKING_PRIORITY_QUEUE_HPP
+
+#include <mutex>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+#include "cache_aligned.hpp"
+#include "priority_heap.hpp"
+
+namespace cybertron::base {
+template <typename T, typename Compare = std::less<T>, typename LockPolicy = StdLockPolicy,
+          typename Heap = DaryHeap<T, Compare>>
+/**
+ * @brief A blocking priority queue with the blocking, timeout and capacity semantics of BlockingQueue. pop() returns
+ * the element ranked highest by {Compare}, like std::priority_queue. {Heap} is the container, see priority_heap.hpp;
+ * use BlockingBucketQueue below when priorities are small integers.
+ *
+ * In non-blocking mode a full queue makes room by dropping its lowest-ranked element, and rejects the new element
+ * instead when that one does not outrank it. Urgent messages therefore survive overload, and bulk ones are shed first.
+ * #NOTE Use it carefully when set the parameter {capacity_limit} to 0 because it may lead to unlimited memory
+ * consumption.
+ */
+class BlockingPriorityQueue : public Noncopyable {
+public:
+    using mutex_type = typename LockPolicy::mutex_type;
+    using condition_type = typename LockPolicy::condition_type;
+
+    /**
+     * @brief Construct a new Blocking Priority Queue object.
+     *
+     * @param capacity_limit The capacity limit of the queue, 0 means unlimited.
+     * @param push_block Whether the push method will work in blocking mode or not.
+     * @param heap The heap instance, to pass a stateful comparator or priority functor.
+     */
+    explicit BlockingPriorityQueue(size_t capacity_limit = 0, bool push_block = false, Heap heap = Heap())
+        : _push_block(push_block),
+          _active(true),
+          _capacity_limit(capacity_limit),
+          _mutex(),
+          _heap(std::move(heap)),
+          _consumer(),
+          _producer() {}
+
+    ~BlockingPriorityQueue() { close(); }
+
+    void close() {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _heap.clear();
+            _active = false;
+        }
+        _producer->notify_all();
+        _consumer->notify_all();
+    }
+
+    /**
+     * @brief Push element within {timeout} microseconds in a blocking way. If the {timeout} parameter is set to 0, then
+     * it will always try to push until success or the queue is closed.
+     *
+     * @param element Input element that is going to be pushed.
+     * @param timeout Timeout in microseconds.
+     * @return true if the element was pushed,
+     * @return false on timeout, if the queue is closed, or if it was shed in non-blocking mode.
+     */
+    bool push(const T& element, const int64_t& timeout = 0) { return _push(element, true, timeout); }
+
+    bool push(T&& element, const int64_t& timeout = 0) { return _push(std::move(element), true, timeout); }
+
+    bool try_push(const T& element) { return _push(element, false, 0); }
+
+    bool try_push(T&& element) { return _push(std::move(element), false, 0); }
+
+    /**
+     * @brief Pop the highest-priority element within {timeout} microseconds in a blocking way. If the {timeout}
+     * parameter is set to 0, then it will always try to pop until success or the queue is closed.
+     *
+     * @param element Output element.
+     * @param timeout Timeout in microseconds.
+     * @return true if one element was popped,
+     * @return false on timeout or if the queue is closed.
+     */
+    bool pop(T& element, const int64_t& timeout = 0) { return _pop(element, true, timeout); }
+
+    bool try_pop(T& element) { return _pop(element, false, 0); }
+
+    size_t size() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _heap.size();
+    }
+
+    size_t capacity() { return _capacity_limit; }
+
+    bool empty() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _heap.empty();
+    }
+
+    bool full() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return !_has_room();
+    }
+
+    T top() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _heap.top();
+    }
+
+    void clear() {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _heap.clear();
+        }
+        _producer->notify_all();
+    }
+
+private:
+    bool _has_room() const { return (!_capacity_limit) || (_heap.size() < _capacity_limit); }
+
+    template <typename U>
+    bool _push(U&& element, bool block, const int64_t& timeout) {
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (_push_block) {
+            if (!block) {
+                if (!_has_room()) {
+                    return false;
+                }
+            } else if (!detail::timed_wait(lock, *_producer, timeout, [&] { return ((!_active) || _has_room()); })) {
+                return false;
+            }
+        } else if (_active && !_has_room()) {
+            if (!_heap.outranks_lowest(element)) {
+                return false;
+            }
+            _heap.drop_lowest();
+        }
+        if (!_active) {
+            return false;
+        }
+        _heap.push(std::forward<U>(element));
+        _consumer->notify_one();
+        return true;
+    }
+
+    bool _pop(T& element, bool block, const int64_t& timeout) {
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (block &&
+            !detail::timed_wait(lock, *_consumer, timeout, [&] { return ((!_active) || (!_heap.empty())); })) {
+            return false;
+        }
+        if ((!_active) || _heap.empty()) {
+            return false;
+        }
+        _heap.take(element);
+        if (_push_block) {
+            _producer->notify_one();
+        }
+        return true;
+    }
+
+private:
+    const bool _push_block;
+    bool _active;  // guarded by _mutex
+    const size_t _capacity_limit;
+    mutex_type _mutex;
+    Heap _heap;  // guarded by _mutex
+    CacheAligned<condition_type> _consumer;  // guarded by _mutex
+    CacheAligned<condition_type> _producer;  // guarded by _mutex
+};
+
+/**
+ * @brief A BlockingPriorityQueue for small integer priorities, O(1) per operation and FIFO within a level. {PriorityOf}
+ * maps an element to a level in [0, Levels), higher levels pop first.
+ *
+ */
+template <typename T, size_t Levels, typename PriorityOf, typename LockPolicy = StdLockPolicy>
+using BlockingBucketQueue = BlockingPriorityQueue<T, std::less<T>, LockPolicy, BucketHeap<T, Levels, PriorityOf>>;
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_BLOCKING_PRIORITY_QUEUE_HPP
@@ -1,7 +1,7 @@
 /**
  * @file blocking_queue.hpp
  * @author FengWenxi (ThorfromAsgard@outlook.com)
- * @brief An implementation of blocking queue using std::condition_variable #NOTE This only works on C++11 standard.
+ * @brief An implementation of blocking queue using a condition variable selected by a locking policy.
  * @version 0.1
  * @date 2024-06-08
  *
@@ -16,21 +16,50 @@
 
 #include <mutex>
 #include <deque>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
 #include <iostream>
+#include <functional>
+#include <system_error>
 #include <condition_variable>
+#if __cplusplus >= 202002L && __has_include(<stop_token>)
+#include <stop_token>
+#endif
+
+#include <cerrno>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 #include "noncopyable.hpp"
+#include "event_count.hpp"
+#include "lock_policy.hpp"
+#include "cache_aligned.hpp"
+#include "memory_budget.hpp"
+#include "wait_list.hpp"
 
 namespace cybertron::base {
-template <typename T>
+class Select;
+
+template <typename T, typename LockPolicy = StdLockPolicy>
 /**
  * @brief An implementation of blocking queue. The queue works in two modes by specifying the {push_block} parameter.
  * #NOTE Use it carefully when set the parameter {capacity_limit} to 0 because it may lead to unlimited memory
  * consumption.
  *
+ * The {LockPolicy} selects the mutex and condition variable, see lock_policy.hpp; with a reader-writer mutex such as
+ * RwSpinLockPolicy's, the read-only accessors like size() take it shared. set_byte_capacity() additionally bounds the
+ * queue by bytes and charges its elements against a shared MemoryBudget, and set_watermarks() signals congestion
+ * upstream before producers block or elements get dropped. set_expiry() / set_ttl() make pops skip stale elements.
  */
 class BlockingQueue : public Noncopyable {
 public:
+    using mutex_type = typename LockPolicy::mutex_type;
+    using condition_type = typename LockPolicy::condition_type;
+
     /**
      * @brief Construct a new Blocking Queue object, use it carefully when set the parameter {capacity_limit} to 0.
      *
@@ -39,15 +68,41 @@ public:
      * @param capacity_limit The capacity limit of the queue, again, you should be very aware of what you are doing when
      * set it to 0, if you are not sure, then you are not aware !!!!!!
      *
+     * @param use_event_fd Whether to create an eventfd that is readable exactly while the queue is non-empty, see
+     * event_fd(). Throws std::system_error if the eventfd cannot be created.
+     *
      */
-    explicit BlockingQueue(size_t capacity_limit = 0, bool push_block = false)
+    explicit BlockingQueue(size_t capacity_limit = 0, bool push_block = false, bool use_event_fd = false)
         : _push_block(push_block),
+          _active(true),
           _capacity_limit(capacity_limit),
+          _event_fd(-1),
           _mutex(),
-          _producer(),
-          _consumer(),
           _dequeue(),
-          _active(true) {
+          _selectors(),
+          _batch_waiters(0),
+          _byte_capacity(0),
+          _bytes(0),
+          _size_of(),
+          _budget(nullptr),
+          _high_watermark(0),
+          _low_watermark(0),
+          _congested(false),
+          _reported(false),
+          _watermark_mutex(),
+          _delivering(false),
+          _on_watermark(),
+          _expiry_of(),
+          _expiries(),
+          _expired(0),
+          _consumer(),
+          _producer() {
+        if (use_event_fd) {
+            _event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (_event_fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "BlockingQueue eventfd");
+            }
+        }
         std::cout << "Blocking Queue capacity: " << _capacity_limit << std::endl;
         if (_capacity_limit == 0) {
             // TODO: Find another way to warning! Use glog instead.
@@ -61,18 +116,45 @@ public:
      *
      * #TODO: Do tests to make sure this works fine!
      */
-    ~BlockingQueue() { close(); }
+    ~BlockingQueue() {
+        close();
+        if (_event_fd >= 0) {
+            ::close(_event_fd);
+        }
+    }
 
+    /**
+     * @brief Close the queue, drop all elements and wake up every waiter. The eventfd, if any, is left readable so an
+     * event loop notices the closure; check closed() and deregister it.
+     *
+     */
     void close() {
         {
-            std::lock_guard<std::mutex> lock(_mutex);
-            _dequeue.clear();
+            WatermarkReporter reporter{this};
+            std::lock_guard<mutex_type> lock(_mutex);
+            _discard_all();
             _active = false;
+            _signal_event_fd();
+            _notify_selectors();
+            _update_watermark();
+            _producer->notify_all();
+            _consumer->notify_all();
         }
-        _producer.notify_all();
-        _consumer.notify_all();
+    }
+
+    bool closed() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return !_active;
     }
 
+    /**
+     * @brief The eventfd given by {use_event_fd}, or -1. It is readable exactly while the queue holds elements (or is
+     * closed), so it can be registered level-triggered with epoll/poll/select next to sockets and timers, and drained
+     * with try_pop_front(). Never read from it directly, the queue keeps its counter in sync.
+     *
+     */
+    int event_fd() const { return _event_fd; }
+
     /**
      * @brief Push element to the back of the queue within {timeout} microseconds in a blocking way. If the {timeout}
      * parameter is set to 0, then it will always try to push until success or the queue is closed.
@@ -84,32 +166,7 @@ public:
      * @return false if it fails.
      */
     bool push_back(const T& element, const int64_t& timeout = 0) {
-        std::unique_lock<std::mutex> lock(_mutex);
-        if (_push_block) {
-            bool is_woken_up = false;
-            if (timeout) {
-                is_woken_up = _producer.wait_for(lock, std::chrono::microseconds(timeout), [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-            } else {
-                _producer.wait(lock, [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-                is_woken_up = true;
-            }
-            if ((!_active) || (!is_woken_up)) {
-                return false;
-            }
-        } else {
-            while (_capacity_limit && _dequeue.size() >= _capacity_limit) {
-                _dequeue.pop_front();
-            }
-        }
-        _dequeue.push_back(element);
-        _consumer.notify_one();
-        return true;
+        return _push(element, false, _timeout_waiter(timeout));
     }
 
     /**
@@ -123,32 +180,7 @@ public:
      * @return false if it fails.
      */
     bool push_back(T&& element, const int64_t& timeout = 0) {
-        std::unique_lock<std::mutex> lock(_mutex);
-        if (_push_block) {
-            bool is_woken_up = false;
-            if (timeout) {
-                is_woken_up = _producer.wait_for(lock, std::chrono::microseconds(timeout), [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-            } else {
-                _producer.wait(lock, [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-                is_woken_up = true;
-            }
-            if ((!_active) || (!is_woken_up)) {
-                return false;
-            }
-        } else {
-            while (_capacity_limit && _dequeue.size() >= _capacity_limit) {
-                _dequeue.pop_front();
-            }
-        }
-        _dequeue.push_back(std::move(element));
-        _consumer.notify_one();
-        return true;
+        return _push(std::move(element), false, _timeout_waiter(timeout));
     }
 
     /**
@@ -162,31 +194,7 @@ public:
      * @return false if it fails.
      */
     bool push_front(const T& element, const int64_t& timeout = 0) {
-        std::unique_lock<std::mutex> lock(_mutex);
-        if (_push_block) {
-            bool is_woken_up = false;
-            if (timeout) {
-                is_woken_up = _producer.wait_for(lock, std::chrono::microseconds(timeout), [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-            } else {
-                _producer.wait(lock, [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-                is_woken_up = true;
-            }
-            if ((!_active) || (!is_woken_up)) {
-                return false;
-            }
-        } else {
-            while (_capacity_limit && _dequeue.size() >= _capacity_limit) {
-                _dequeue.pop_back();
-            }
-        }
-        _dequeue.push_front(element);
-        _consumer.notify_one();
+        return _push(element, true, _timeout_waiter(timeout));
     }
 
     /**
@@ -199,32 +207,8 @@ public:
      * to the front of the queue,
      * @return false if it fails.
      */
-    bool push_front(T&& item, const int64_t& timeout = 0) {
-        std::unique_lock<std::mutex> lock(_mutex);
-        if (_push_block) {
-            bool is_woken_up = false;
-            if (timeout) {
-                is_woken_up = _producer.wait_for(lock, std::chrono::microseconds(timeout), [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-            } else {
-                _producer.wait(lock, [&] {
-                    return ((!_active) || (!_capacity_limit) ||
-                            (_capacity_limit && (_dequeue.size() < _capacity_limit)));
-                });
-                is_woken_up = true;
-            }
-            if ((!_active) || (!is_woken_up)) {
-                return false;
-            }
-        } else {
-            while (_capacity_limit && _dequeue.size() >= _capacity_limit) {
-                _dequeue.pop_back();
-            }
-        }
-        _dequeue.push_front(std::move(item));
-        _consumer.notify_one();
+    bool push_front(T&& element, const int64_t& timeout = 0) {
+        return _push(std::move(element), true, _timeout_waiter(timeout));
     }
 
     /**
@@ -238,24 +222,7 @@ public:
      * @return false if it fails.
      */
     bool pop_front(T& element, const int64_t& timeout = 0) {
-        std::unique_lock<std::mutex> lock(_mutex);
-        bool is_woken_up = false;
-        if (timeout) {
-            is_woken_up = _consumer.wait_for(lock, std::chrono::microseconds(timeout),
-                                             [&] { return ((!_active) || (!_dequeue.empty())); });
-        } else {
-            _consumer.wait(lock, [&] { return ((!_active) || (!_dequeue.empty())); });
-            is_woken_up = true;
-        }
-        if ((!_active) || (!is_woken_up)) {
-            return false;
-        };
-        element = _dequeue.front();
-        _dequeue.pop_front();
-        if (_push_block) {
-            _producer.notify_one();
-        }
-        return true;
+        return _pop(element, true, _timeout_waiter(timeout));
     }
 
     /**
@@ -269,67 +236,824 @@ public:
      * @return false if it fails.
      */
     bool pop_back(T& element, const int64_t& timeout = 0) {
-        std::unique_lock<std::mutex> lock(_mutex);
-        bool is_woken_up = false;
-        if (timeout) {
-            is_woken_up = _consumer.wait_for(lock, std::chrono::microseconds(timeout),
-                                             [&] { return ((!_active) || (!_dequeue.empty())); });
-        } else {
-            _consumer.wait(lock, [&] { return ((!_active) || (!_dequeue.empty())); });
-            is_woken_up = true;
+        return _pop(element, false, _timeout_waiter(timeout));
+    }
+
+    /**
+     * @brief Pop the front element of the queue if there is one, without blocking.
+     *
+     * @param element Output element.
+     * @return true if one element was popped, false if the queue is empty or closed.
+     */
+    bool try_pop_front(T& element) { return _try_pop(element, true); }
+
+    /**
+     * @brief Pop the back element of the queue if there is one, without blocking.
+     *
+     * @param element Output element.
+     * @return true if one element was popped, false if the queue is empty or closed.
+     */
+    bool try_pop_back(T& element) { return _try_pop(element, false); }
+
+    /**
+     * @brief Pop a batch of up to {max_n} elements from the front of the queue and append them to {out}. It waits
+     * within {timeout} microseconds for the first element (0 means until one arrives or the queue is closed), then
+     * lingers for at most {max_linger} microseconds to fill the batch, returning as soon as {max_n} elements are
+     * collected. A {max_linger} of 0 returns right away with whatever is queued.
+     *
+     * While lingering the consumer sleeps until the whole remainder of the batch is queued (or the queue is full)
+     * rather than waking up per element, and drains it in one go.
+     *
+     * @param out Output elements, appended to.
+     * @param max_n The maximum size of the batch.
+     * @param max_linger The maximum time in microseconds to wait for more elements once the first one is there.
+     * @param timeout Timeout in microseconds for the first element.
+     * @return the number of elements appended to {out}, 0 on timeout or if the queue is closed.
+     */
+    size_t pop_batch(std::vector<T>& out, size_t max_n, const int64_t& max_linger, const int64_t& timeout = 0) {
+        if (!max_n) {
+            return 0;
         }
-        if ((!_active) || (!is_woken_up)) {
-            return false;
-        };
-        element = _dequeue.back();
-        _dequeue.pop_back();
-        if (_push_block) {
-            _producer.notify_one();
+        WatermarkReporter reporter{this};
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (!detail::timed_wait(lock, *_consumer, timeout, [&] { return ((!_active) || _has_live(true)); })) {
+            return 0;
         }
-        return true;
+        size_t taken = 0;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(max_linger);
+        ++_batch_waiters;
+        while (_active) {
+            taken += _take_batch(out, max_n - taken);
+            if (taken == max_n || (!max_linger)) {
+                break;
+            }
+            size_t need = max_n - taken;
+            if (!detail::deadline_wait(lock, *_consumer, deadline,
+                                       [&] { return ((!_active) || (_dequeue.size() >= need) || (!_has_room())); })) {
+                if (_active) {
+                    taken += _take_batch(out, max_n - taken);
+                }
+                break;
+            }
+        }
+        --_batch_waiters;
+        return taken;
+    }
+
+    /**
+     * @brief Deadline flavours of push_back / push_front / pop_front / pop_back: wait until the absolute {deadline}
+     * instead of a relative timeout, so a caller retrying in a loop keeps one fixed deadline and does not drift.
+     * time_point::max() means forever.
+     *
+     * @return true on success, false if the deadline passed or the queue is closed.
+     */
+    template <typename Clock, typename Duration>
+    bool push_back(const T& element, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return _push(element, false, _deadline_waiter(deadline));
+    }
+
+    template <typename Clock, typename Duration>
+    bool push_back(T&& element, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return _push(std::move(element), false, _deadline_waiter(deadline));
+    }
+
+    template <typename Clock, typename Duration>
+    bool push_front(const T& element, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return _push(element, true, _deadline_waiter(deadline));
+    }
+
+    template <typename Clock, typename Duration>
+    bool push_front(T&& element, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return _push(std::move(element), true, _deadline_waiter(deadline));
+    }
+
+    template <typename Clock, typename Duration>
+    bool pop_front(T& element, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return _pop(element, true, _deadline_waiter(deadline));
+    }
+
+    template <typename Clock, typename Duration>
+    bool pop_back(T& element, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return _pop(element, false, _deadline_waiter(deadline));
+    }
+
+#if defined(__cpp_lib_jthread)
+    /**
+     * @brief Cancellable flavours: like the deadline ones, but also give up as soon as stop is requested on {token}.
+     * Each of these calls parks a wait node of its own, and the stop request wakes that node alone; the other waiters
+     * keep sleeping and nobody has to close() the queue.
+     *
+     * @return true on success, false if stop was requested, the deadline passed or the queue is closed.
+     */
+    template <typename Clock = std::chrono::steady_clock, typename Duration = typename Clock::duration>
+    bool push_back(const T& element, std::stop_token token,
+                   const std::chrono::time_point<Clock, Duration>& deadline =
+                       std::chrono::time_point<Clock, Duration>::max()) {
+        typename Waiters::Waiter parked;
+        MemoryBudget::Waiter budget_parked;
+        std::stop_callback wake(token, [&] { _wake_producer(parked, budget_parked); });
+        return _push(element, false, _stoppable_waiter(token, parked, deadline),
+                     _stoppable_waiter(token, budget_parked, deadline));
+    }
+
+    template <typename Clock = std::chrono::steady_clock, typename Duration = typename Clock::duration>
+    bool push_back(T&& element, std::stop_token token,
+                   const std::chrono::time_point<Clock, Duration>& deadline =
+                       std::chrono::time_point<Clock, Duration>::max()) {
+        typename Waiters::Waiter parked;
+        MemoryBudget::Waiter budget_parked;
+        std::stop_callback wake(token, [&] { _wake_producer(parked, budget_parked); });
+        return _push(std::move(element), false, _stoppable_waiter(token, parked, deadline),
+                     _stoppable_waiter(token, budget_parked, deadline));
+    }
+
+    template <typename Clock = std::chrono::steady_clock, typename Duration = typename Clock::duration>
+    bool push_front(const T& element, std::stop_token token,
+                    const std::chrono::time_point<Clock, Duration>& deadline =
+                        std::chrono::time_point<Clock, Duration>::max()) {
+        typename Waiters::Waiter parked;
+        MemoryBudget::Waiter budget_parked;
+        std::stop_callback wake(token, [&] { _wake_producer(parked, budget_parked); });
+        return _push(element, true, _stoppable_waiter(token, parked, deadline),
+                     _stoppable_waiter(token, budget_parked, deadline));
+    }
+
+    template <typename Clock = std::chrono::steady_clock, typename Duration = typename Clock::duration>
+    bool push_front(T&& element, std::stop_token token,
+                    const std::chrono::time_point<Clock, Duration>& deadline =
+                        std::chrono::time_point<Clock, Duration>::max()) {
+        typename Waiters::Waiter parked;
+        MemoryBudget::Waiter budget_parked;
+        std::stop_callback wake(token, [&] { _wake_producer(parked, budget_parked); });
+        return _push(std::move(element), true, _stoppable_waiter(token, parked, deadline),
+                     _stoppable_waiter(token, budget_parked, deadline));
     }
 
+    template <typename Clock = std::chrono::steady_clock, typename Duration = typename Clock::duration>
+    bool pop_front(T& element, std::stop_token token,
+                   const std::chrono::time_point<Clock, Duration>& deadline =
+                       std::chrono::time_point<Clock, Duration>::max()) {
+        typename Waiters::Waiter parked;
+        std::stop_callback wake(token, [&] { _wake_consumer(parked); });
+        return _pop(element, true, _stoppable_waiter(token, parked, deadline));
+    }
+
+    template <typename Clock = std::chrono::steady_clock, typename Duration = typename Clock::duration>
+    bool pop_back(T& element, std::stop_token token,
+                  const std::chrono::time_point<Clock, Duration>& deadline =
+                      std::chrono::time_point<Clock, Duration>::max()) {
+        typename Waiters::Waiter parked;
+        std::stop_callback wake(token, [&] { _wake_consumer(parked); });
+        return _pop(element, false, _stoppable_waiter(token, parked, deadline));
+    }
+#endif
+
+    /**
+     * @brief Push element to the back of the queue only if that is possible without blocking. In non-blocking mode this
+     * always succeeds on an open queue, dropping from the front when full.
+     *
+     * @param element Input element that is going to be pushed.
+     * @return true if the element was pushed, false if the queue is full or closed.
+     */
+    bool try_push_back(const T& element) { return _try_push(element, false); }
+
+    bool try_push_back(T&& element) { return _try_push(std::move(element), false); }
+
+    /**
+     * @brief Push element to the front of the queue only if that is possible without blocking. In non-blocking mode
+     * this always succeeds on an open queue, dropping from the back when full.
+     *
+     * @param element Input element that is going to be pushed.
+     * @return true if the element was pushed, false if the queue is full or closed.
+     */
+    bool try_push_front(const T& element) { return _try_push(element, true); }
+
+    bool try_push_front(T&& element) { return _try_push(std::move(element), true); }
+
     size_t size() {
-        std::lock_guard<std::mutex> lock(_mutex);
+        detail::ReadLock<mutex_type> lock(_mutex);
         return _dequeue.size();
     }
 
     size_t capacity() { return _capacity_limit; }
 
+    /**
+     * @brief Bound the queue by bytes as well as by elements. {size_of} gives the footprint of an element and must
+     * return the same value for it every time; the queue then holds at most {byte_capacity} bytes, 0 meaning no byte
+     * limit of its own. An element larger than that is still accepted into an empty queue.
+     *
+     * With a {budget}, e.g. &MemoryBudget::get_instance(), every element is also charged against that shared budget
+     * until it leaves the queue. Blocking producers wait for the budget outside the queue lock, non-blocking ones drop
+     * the oldest elements of this queue until the budget has room, and fail if even an empty queue cannot get it.
+     *
+     * Call it while the queue is still empty, before producers start.
+     */
+    void set_byte_capacity(size_t byte_capacity, std::function<size_t(const T&)> size_of,
+                           MemoryBudget* budget = nullptr) {
+        std::lock_guard<mutex_type> lock(_mutex);
+        _byte_capacity = byte_capacity;
+        _size_of = std::move(size_of);
+        _budget = budget;
+    }
+
+    size_t byte_capacity() {
+        detail::ReadLock<mutex_type> lock(_mutex);
+        return _byte_capacity;
+    }
+
+    /**
+     * @brief The bytes held by the queue as measured by the {size_of} of set_byte_capacity(), or 0 without one.
+     *
+     */
+    size_t bytes() {
+        detail::ReadLock<mutex_type> lock(_mutex);
+        return _bytes;
+    }
+
+    /**
+     * @brief Watch the depth of the queue with hysteresis: it becomes congested once it holds {high} elements and
+     * stays so until it drains back to {low}, so a queue hovering around one threshold does not flap. Upstream stages
+     * can poll congested() or get {on_change} called with the new state, to throttle or shed load before push_back()
+     * blocks or starts evicting.
+     *
+     * {on_change} runs in the thread whose push or pop crossed the watermark, with no lock held, so it may use the
+     * queue and even call set_watermarks(). Calls never overlap, always alternate between true and false, and end on
+     * the current state; a crossing undone before it was reported may be skipped.
+     *
+     * @param high The depth at which the queue becomes congested, 0 turns watermarks off.
+     * @param low The depth at which it stops being congested, must be below {high}.
+     * @param on_change Optional callback taking the new congestion state.
+     */
+    void set_watermarks(size_t high, size_t low, std::function<void(bool)> on_change = nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(_watermark_mutex);
+            _on_watermark = std::move(on_change);
+        }
+        WatermarkReporter reporter{this};
+        std::lock_guard<mutex_type> lock(_mutex);
+        _high_watermark = high;
+        _low_watermark = (high && low >= high) ? high - 1 : low;
+        _update_watermark();
+    }
+
+    /**
+     * @brief Whether the queue is congested per set_watermarks(). A single atomic load, cheap enough to poll on every
+     * push.
+     *
+     */
+    bool congested() const { return _congested.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Give every element an expiry, stamped when it is pushed: {expiry_of} maps an element to the steady_clock
+     * time after which nobody wants it anymore, e.g. the deadline of the request it carries. Pops then drop expired
+     * elements instead of handing out stale work, and count them in expired_count(). The stamps are kept next to the
+     * elements, so a run of expired ones is found and dropped in bulk without looking at the payloads.
+     *
+     * Elements already queued never expire. Pass nullptr to turn expiry off again.
+     */
+    void set_expiry(std::function<std::chrono::steady_clock::time_point(const T&)> expiry_of) {
+        std::lock_guard<mutex_type> lock(_mutex);
+        _expiry_of = std::move(expiry_of);
+        _expiries.clear();
+        if (_expiry_of) {
+            for (const T& element : _dequeue) {
+                _expiries.push_back({std::chrono::steady_clock::time_point::max(), _size_of ? _size_of(element) : 0});
+            }
+        }
+    }
+
+    /**
+     * @brief Expire every element {ttl} after it was pushed, see set_expiry().
+     *
+     */
+    template <typename Rep, typename Period>
+    void set_ttl(const std::chrono::duration<Rep, Period>& ttl) {
+        auto duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(ttl);
+        set_expiry([duration](const T&) { return std::chrono::steady_clock::now() + duration; });
+    }
+
+    /**
+     * @brief The number of elements dropped on expiry since construction.
+     *
+     */
+    uint64_t expired_count() {
+        detail::ReadLock<mutex_type> lock(_mutex);
+        return _expired;
+    }
+
     bool empty() {
-        std::lock_guard<std::mutex> lock(_mutex);
+        detail::ReadLock<mutex_type> lock(_mutex);
         return _dequeue.empty();
     }
 
     bool full() {
-        std::lock_guard<std::mutex> lock(_mutex);
-        return (_dequeue.size() >= _capacity_limit);
+        detail::ReadLock<mutex_type> lock(_mutex);
+        return !_has_room();
     }
 
     T front() {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<mutex_type> lock(_mutex);
         return _dequeue.front();
     }
 
     T back() {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<mutex_type> lock(_mutex);
         return _dequeue.back();
     }
 
     void clear() {
-        std::lock_guard<std::mutex> lock(_mutex);
-        while (_dequeue.size()) {}
+        {
+            WatermarkReporter reporter{this};
+            std::lock_guard<mutex_type> lock(_mutex);
+            _discard_all();
+            _drain_event_fd();
+            _notify_selectors();
+            _update_watermark();
+            _producer->notify_all();
+        }
+    }
+
+private:
+    friend class Select;
+
+    using Waiters = WaitList<condition_type>;
+
+    // {bytes} is the size of the element about to be pushed, if any. An empty queue always has room, so an element
+    // larger than the byte capacity cannot block forever.
+    bool _has_room(size_t bytes = 0) const {
+        if (_capacity_limit && _dequeue.size() >= _capacity_limit) {
+            return false;
+        }
+        return (!_byte_capacity) || _dequeue.empty() || (_bytes < _byte_capacity && _bytes + bytes <= _byte_capacity);
+    }
+
+    // A waiter blocks on a condition until a predicate holds and returns its final value. It is the only thing that
+    // differs between the timeout, deadline and cancellable flavours of push and pop. A push may wait twice, for the
+    // memory budget and for the queue, so a timeout is turned into a deadline once up front.
+    static auto _timeout_waiter(const int64_t& timeout) {
+        return _deadline_waiter(timeout ? std::chrono::steady_clock::now() + std::chrono::microseconds(timeout)
+                                        : std::chrono::steady_clock::time_point::max());
+    }
+
+    template <typename Clock, typename Duration>
+    static auto _deadline_waiter(const std::chrono::time_point<Clock, Duration>& deadline) {
+        return [deadline](auto& lock, auto& condition, auto predicate) {
+            return detail::deadline_wait(lock, condition, deadline, predicate);
+        };
+    }
+
+#if defined(__cpp_lib_jthread)
+    // Waits on the node {waiter}, which the stop callback of the caller wakes on its own. {waiter} is a node of the
+    // wait list the waiter is called with: the queue's for the queue, the budget's for the budget.
+    template <typename Waiter, typename Clock, typename Duration>
+    static auto _stoppable_waiter(const std::stop_token& token, Waiter& waiter,
+                                  const std::chrono::time_point<Clock, Duration>& deadline) {
+        return [&token, &waiter, deadline](auto& lock, auto& list, auto predicate) {
+            bool satisfied =
+                list.wait_until(lock, waiter, deadline, [&] { return token.stop_requested() || predicate(); });
+            if (token.stop_requested()) {
+                list.pass_on(waiter);
+                return false;
+            }
+            return satisfied;
+        };
+    }
+
+    // The stop callbacks run in the thread requesting stop, or inline when registered on an already stopped token,
+    // never under _mutex. Under the lock a waiter is either parked or has yet to check its token, so it cannot miss it.
+    void _wake_consumer(typename Waiters::Waiter& parked) {
+        std::lock_guard<mutex_type> lock(_mutex);
+        _consumer->notify(parked);
+    }
+
+    void _wake_producer(typename Waiters::Waiter& parked, MemoryBudget::Waiter& budget_parked) {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _producer->notify(parked);
+        }
+        if (_budget) {
+            _budget->wake(budget_parked);
+        }
+    }
+#endif
+
+    template <typename U, typename Waiter>
+    bool _push(U&& element, bool front, Waiter&& wait) {
+        return _push(std::forward<U>(element), front, wait, wait);
+    }
+
+    // {budget_wait} waits for the memory budget, {wait} for the queue.
+    template <typename U, typename Waiter, typename BudgetWaiter>
+    bool _push(U&& element, bool front, Waiter&& wait, BudgetWaiter&& budget_wait) {
+        size_t bytes = _size_of ? _size_of(element) : 0;
+        // A blocking producer waits for the shared budget before it takes the queue lock, so a budget spent by other
+        // queues never stalls the consumers of this one.
+        bool charged = _push_block && _budget;
+        if (charged && !_budget->acquire_with(bytes, budget_wait)) {
+            return false;
+        }
+        WatermarkReporter reporter{this};
+        std::unique_lock<mutex_type> lock(_mutex);
+        bool ready = (!_push_block) || wait(lock, *_producer, [&] { return ((!_active) || _has_room(bytes)); });
+        if ((!ready) || (!_active) || (!(charged || _charge(bytes, front)))) {
+            if (charged) {
+                _budget->release(bytes);
+            }
+            return false;
+        }
+        _insert(std::forward<U>(element), front, bytes);
+        return true;
+    }
+
+    template <typename U>
+    bool _try_push(U&& element, bool front) {
+        WatermarkReporter reporter{this};
+        std::lock_guard<mutex_type> lock(_mutex);
+        size_t bytes = _size_of ? _size_of(element) : 0;
+        if ((!_active) || (_push_block && !_has_room(bytes)) || (!_charge(bytes, front))) {
+            return false;
+        }
+        _insert(std::forward<U>(element), front, bytes);
+        return true;
+    }
+
+    // Must hold _mutex. Takes {bytes} from the budget, if any, without blocking. In non-blocking mode it makes the
+    // budget room by dropping from the opposite end of the queue, unless what other queues hold leaves no room even
+    // once this one is empty.
+    bool _charge(size_t bytes, bool front) {
+        if ((!_budget) || _budget->try_acquire(bytes)) {
+            return true;
+        }
+        if (_push_block || _dequeue.empty() || (!_budget->fits_without(bytes, _bytes))) {
+            return false;
+        }
+        bool charged = false;
+        do {
+            _discard(!front);
+            charged = _budget->try_acquire(bytes);
+        } while ((!charged) && (!_dequeue.empty()));
+        // On success _insert() follows and does this; on failure other queues took the budget first, and the drops
+        // must still be seen like those of a pop. Non-blocking mode has no producers to wake.
+        if (!charged) {
+            if (_dequeue.empty()) {
+                _drain_event_fd();
+            }
+            _notify_selectors();
+            _update_watermark();
+        }
+        return charged;
+    }
+
+    // Must hold _mutex, {bytes} is already charged to the budget. In non-blocking mode this makes room by dropping
+    // from the opposite end.
+    template <typename U>
+    void _insert(U&& element, bool front, size_t bytes) {
+        while (!_has_room(bytes)) {
+            _discard(!front);
+        }
+        _bytes += bytes;
+        if (_dequeue.empty()) {
+            _signal_event_fd();
+        }
+        if (_expiry_of) {
+            ExpiryStamp stamp{_expiry_of(element), bytes};
+            front ? _expiries.push_front(stamp) : _expiries.push_back(stamp);
+        }
+        if (front) {
+            _dequeue.push_front(std::forward<U>(element));
+        } else {
+            _dequeue.push_back(std::forward<U>(element));
+        }
+        // A lingering pop_batch() waits for more than one element, so a single wakeup could be swallowed by it while a
+        // plain consumer stays asleep.
+        if (_batch_waiters) {
+            _consumer->notify_all();
+        } else {
+            _consumer->notify_one();
+        }
+        _notify_selectors();
+        _update_watermark();
+    }
+
+    template <typename Waiter>
+    bool _pop(T& element, bool front, Waiter&& wait) {
+        WatermarkReporter reporter{this};
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (!wait(lock, *_consumer, [&] { return ((!_active) || _has_live(front)); })) {
+            return false;
+        }
+        if (!_active) {
+            return false;
+        }
+        _take(element, front);
+        return true;
+    }
+
+    bool _try_pop(T& element, bool front) {
+        WatermarkReporter reporter{this};
+        std::lock_guard<mutex_type> lock(_mutex);
+        if ((!_active) || (!_has_live(front))) {
+            return false;
+        }
+        _take(element, front);
+        return true;
+    }
+
+    // Must hold _mutex and the queue must not be empty.
+    void _take(T& element, bool front) {
+        _uncharge(front ? _dequeue.front() : _dequeue.back());
+        if (front) {
+            element = std::move(_dequeue.front());
+            _dequeue.pop_front();
+        } else {
+            element = std::move(_dequeue.back());
+            _dequeue.pop_back();
+        }
+        _pop_expiry(front);
+        if (_dequeue.empty()) {
+            _drain_event_fd();
+        }
+        if (_push_block) {
+            _producer->notify_one();
+        }
+        _notify_selectors();
+        _update_watermark();
+    }
+
+    // Must hold _mutex. Moves up to {max_n} live elements from the front into {out}, dropping expired ones on the way,
+    // with one round of notifications.
+    size_t _take_batch(std::vector<T>& out, size_t max_n) {
+        auto now = _expiry_of ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        size_t count = 0;
+        size_t taken = 0;
+        for (; count < _dequeue.size() && taken < max_n; ++count) {
+            if (_expiry_of && _expiries[count].expiry <= now) {
+                _uncharge_bytes(_expiries[count].bytes);
+                ++_expired;
+            } else {
+                _uncharge(_dequeue[count]);
+                out.push_back(std::move(_dequeue[count]));
+                ++taken;
+            }
+        }
+        if (!count) {
+            return 0;
+        }
+        _erase(true, count);
+        if (_dequeue.empty()) {
+            _drain_event_fd();
+        }
+        if (_push_block) {
+            if (count > 1) {
+                _producer->notify_all();
+            } else {
+                _producer->notify_one();
+            }
+        }
+        _notify_selectors();
+        _update_watermark();
+        return taken;
+    }
+
+    // Must hold _mutex. Drops the expired elements at the front or the back in one go, judging by their stamps alone,
+    // and returns whether a live element is left.
+    bool _has_live(bool front) {
+        if ((!_expiry_of) || _dequeue.empty()) {
+            return !_dequeue.empty();
+        }
+        auto now = std::chrono::steady_clock::now();
+        size_t size = _expiries.size();
+        size_t count = 0;
+        while (count < size && _expiries[front ? count : size - 1 - count].expiry <= now) {
+            ++count;
+        }
+        if (!count) {
+            return true;
+        }
+        for (size_t i = 0; _size_of && i < count; ++i) {
+            _uncharge_bytes(_expiries[front ? i : size - 1 - i].bytes);
+        }
+        _erase(front, count);
+        _expired += count;
+        if (_dequeue.empty()) {
+            _drain_event_fd();
+        }
+        if (_push_block) {
+            _producer->notify_all();
+        }
+        _notify_selectors();
+        _update_watermark();
+        return !_dequeue.empty();
+    }
+
+    // Must hold _mutex. Removes {count} elements and their expiry stamps from the front or the back.
+    void _erase(bool front, size_t count) {
+        auto offset = static_cast<std::ptrdiff_t>(count);
+        if (front) {
+            _dequeue.erase(_dequeue.begin(), _dequeue.begin() + offset);
+            if (_expiry_of) {
+                _expiries.erase(_expiries.begin(), _expiries.begin() + offset);
+            }
+        } else {
+            _dequeue.erase(_dequeue.end() - offset, _dequeue.end());
+            if (_expiry_of) {
+                _expiries.erase(_expiries.end() - offset, _expiries.end());
+            }
+        }
+    }
+
+    // Must hold _mutex. Keeps the expiry stamps in step with a single pop from the front or the back.
+    void _pop_expiry(bool front) {
+        if (_expiry_of) {
+            front ? _expiries.pop_front() : _expiries.pop_back();
+        }
+    }
+
+    // Must hold _mutex. Called after every change of depth.
+    void _update_watermark() {
+        bool congested = _congested.load(std::memory_order_relaxed);
+        bool flip = false;
+        if (!_high_watermark) {
+            flip = congested;
+        } else if (!congested) {
+            flip = _dequeue.size() >= _high_watermark;
+        } else {
+            flip = _dequeue.size() <= _low_watermark;
+        }
+        if (!flip) {
+            return;
+        }
+        _congested.store(!congested, std::memory_order_release);
+        // Only the operation that flipped the state has a crossing to report.
+        WatermarkReporter* reporter = WatermarkReporter::current();
+        if (reporter && reporter->queue == this) {
+            reporter->flipped = true;
+        }
+    }
+
+    // Delivers pending watermark crossings once _mutex is released, called by an operation that flipped _congested.
+    // One thread at a time delivers, always the latest state, and calls a copy of the callback without holding
+    // _watermark_mutex, so the callback may come back into the queue. A thread that finds a delivery under way leaves
+    // its crossing to that thread, which re-checks the state after every call until nothing is pending.
+    //
+    // The fast path and the re-check form a store-buffer pattern: the changer stores _congested then loads _reported,
+    // the deliverer stores _reported then loads _congested. The two seq_cst fences make sure at least one of them sees
+    // the other's store, so a crossing is never left behind by both. Operations that flip nothing skip all of this.
+    void _report_watermark() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_congested.load(std::memory_order_acquire) == _reported.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(_watermark_mutex);
+        if (_delivering) {
+            return;
+        }
+        _delivering = true;
+        for (;;) {
+            bool congested = _congested.load(std::memory_order_acquire);
+            if (congested == _reported.load(std::memory_order_relaxed)) {
+                break;
+            }
+            _reported.store(congested, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::function<void(bool)> on_change = _on_watermark;
+            lock.unlock();
+            if (on_change) {
+                on_change(congested);
+            }
+            lock.lock();
+        }
+        _delivering = false;
+    }
+
+    // Kept next to each element while expiry is on, so expired ones can be dropped and uncharged without reading them.
+    struct ExpiryStamp {
+        std::chrono::steady_clock::time_point expiry;
+        size_t bytes;  // what the element was charged when it was pushed
+    };
+
+    // Declared before the lock of an operation that changes the depth, so it is destroyed after the lock is released.
+    // It is the innermost reporter of its thread while alive, which is how _update_watermark() finds it to flag a
+    // flip under _mutex; an operation that flips nothing then costs no fence.
+    struct WatermarkReporter {
+        BlockingQueue* queue;
+        WatermarkReporter* outer;
+        bool flipped;
+
+        explicit WatermarkReporter(BlockingQueue* owner)
+            : queue(owner), outer(std::exchange(current(), this)), flipped(false) {}
+
+        ~WatermarkReporter() {
+            current() = outer;
+            if (flipped) {
+                queue->_report_watermark();
+            }
+        }
+
+        static WatermarkReporter*& current() {
+            thread_local WatermarkReporter* reporter = nullptr;
+            return reporter;
+        }
+    };
+
+    // Must hold _mutex and the queue must not be empty. Drops one element from the front or the back.
+    void _discard(bool front) {
+        if (front) {
+            _uncharge(_dequeue.front());
+            _dequeue.pop_front();
+        } else {
+            _uncharge(_dequeue.back());
+            _dequeue.pop_back();
+        }
+        _pop_expiry(front);
+    }
+
+    // Must hold _mutex.
+    void _discard_all() {
+        for (auto it = _dequeue.begin(); _size_of && it != _dequeue.end(); ++it) {
+            _uncharge(*it);
+        }
         _dequeue.clear();
+        _expiries.clear();
+    }
+
+    // Must hold _mutex. Accounts for {element} leaving the queue.
+    void _uncharge(const T& element) {
+        if (_size_of) {
+            _uncharge_bytes(_size_of(element));
+        }
+    }
+
+    // Must hold _mutex. Accounts for {bytes} charged by an element leaving the queue.
+    void _uncharge_bytes(size_t bytes) {
+        _bytes -= bytes;
+        if (_budget) {
+            _budget->release(bytes);
+        }
+    }
+
+    // Select registers its EventCount here for the duration of a wait(), and gets poked on every state change.
+    void _attach_selector(EventCount* event) {
+        std::lock_guard<mutex_type> lock(_mutex);
+        _selectors.push_back(event);
+    }
+
+    void _detach_selector(EventCount* event) {
+        std::lock_guard<mutex_type> lock(_mutex);
+        _selectors.erase(std::find(_selectors.begin(), _selectors.end(), event));
+    }
+
+    void _notify_selectors() {
+        for (EventCount* event : _selectors) {
+            event->notify();
+        }
+    }
+
+    // The eventfd counter is non-zero exactly while the queue is non-empty or closed. Both helpers must hold _mutex.
+    void _signal_event_fd() {
+        if (_event_fd >= 0) {
+            uint64_t one = 1;
+            ssize_t ret = ::write(_event_fd, &one, sizeof(one));
+            (void)ret;  // Can only fail once the counter is already readable, which is what we want anyway.
+        }
+    }
+
+    void _drain_event_fd() {
+        if (_event_fd >= 0 && _active) {
+            uint64_t count = 0;
+            ssize_t ret = ::read(_event_fd, &count, sizeof(count));
+            (void)ret;  // EAGAIN means it was not readable in the first place.
+        }
     }
 
 private:
+    // Queue contents metadata, touched by both sides on every operation.
     const bool _push_block;
-    bool _active;
+    bool _active;  // guarded by _mutex
     const size_t _capacity_limit;
-    std::mutex _mutex;
-    std::condition_variable _consumer;  // guarded by _mutex
-    std::condition_variable _producer;  // guarded by _mutex
-    std::deque<T> _dequeue;             // guarded by _mutex
+    int _event_fd;
+    mutex_type _mutex;
+    std::deque<T> _dequeue;               // guarded by _mutex
+    std::vector<EventCount*> _selectors;  // guarded by _mutex
+    size_t _batch_waiters;                // guarded by _mutex
+    size_t _byte_capacity;                // guarded by _mutex
+    size_t _bytes;                        // guarded by _mutex
+    std::function<size_t(const T&)> _size_of;
+    MemoryBudget* _budget;
+    size_t _high_watermark;  // guarded by _mutex
+    size_t _low_watermark;   // guarded by _mutex
+    std::atomic<bool> _congested;
+    std::atomic<bool> _reported;  // the state last handed to _on_watermark, written under _watermark_mutex
+    std::mutex _watermark_mutex;
+    bool _delivering;                         // guarded by _watermark_mutex
+    std::function<void(bool)> _on_watermark;  // guarded by _watermark_mutex
+    std::function<std::chrono::steady_clock::time_point(const T&)> _expiry_of;
+    std::deque<ExpiryStamp> _expiries;  // guarded by _mutex, in step with _dequeue
+    uint64_t _expired;                  // guarded by _mutex
+    // Waiter state lives on lines of its own, so parking and waking one side does not invalidate the line the other
+    // side needs to take the lock and touch the deque.
+    CacheAligned<Waiters> _consumer;  // guarded by _mutex
+    CacheAligned<Waiters> _producer;  // guarded by _mutex
 };
 
 }  // namespace cybertron::base
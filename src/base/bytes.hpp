@@ -0,0 +1,265 @@
+/**
+ * @file bytes.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Immutable reference-counted byte buffers with zero-copy slicing.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_BYTES_HPP
+#define CYBERTRON_BASE_BYTES_HPP
+
+#include <new>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+#include "copyable.hpp"
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+namespace detail {
+// The header of a byte buffer, allocated together with its bytes, which follow it directly.
+struct BytesStorage {
+    std::atomic<uint32_t> refs;
+    size_t capacity;
+
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+
+    static BytesStorage* allocate(size_t capacity) {
+        void* memory = ::operator new(sizeof(BytesStorage) + capacity);
+        BytesStorage* storage = new (memory) BytesStorage;
+        storage->refs.store(1, std::memory_order_relaxed);
+        storage->capacity = capacity;
+        return storage;
+    }
+
+    void retain() { refs.fetch_add(1, std::memory_order_relaxed); }
+
+    void release() {
+        // Acquire-release so the last owner sees every access of the others before freeing.
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->~BytesStorage();
+            ::operator delete(this);
+        }
+    }
+};
+}  // namespace detail
+
+/**
+ * @brief An immutable view of a reference-counted byte buffer, in the spirit of folly's IOBuf or Rust's Bytes. The
+ * buffer and its count live in one allocation; copying a Bytes only bumps the count and slicing only narrows the view,
+ * so a message parsed once can be fanned out, stripped of headers and handed through any number of queues without its
+ * payload ever being copied. The buffer is freed with its last view.
+ *
+ * A Bytes is three words and cheap to move, so queue it by value: BlockingQueue<Bytes>, Channel<Bytes> and the rest
+ * only ever move the handle. The bytes themselves never change after freeze(), so views can be read from any number
+ * of threads without synchronization; a single Bytes object is as thread-safe as an int.
+ */
+class Bytes : public Copyable {
+public:
+    Bytes() : _storage(nullptr), _data(nullptr), _size(0) {}
+
+    Bytes(const Bytes& other) : _storage(other._storage), _data(other._data), _size(other._size) {
+        if (_storage) {
+            _storage->retain();
+        }
+    }
+
+    Bytes(Bytes&& other) noexcept : _storage(other._storage), _data(other._data), _size(other._size) {
+        other._storage = nullptr;
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    Bytes& operator=(Bytes other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~Bytes() {
+        if (_storage) {
+            _storage->release();
+        }
+    }
+
+    /**
+     * @brief Copy {size} bytes at {data} into a new buffer. The only copy a payload should ever need.
+     *
+     */
+    static Bytes copy(const void* data, size_t size) {
+        detail::BytesStorage* storage = detail::BytesStorage::allocate(size);
+        if (size) {
+            std::memcpy(storage->data(), data, size);
+        }
+        return Bytes(storage, storage->data(), size);
+    }
+
+    static Bytes copy(std::string_view text) { return copy(text.data(), text.size()); }
+
+    const char* data() const { return _data; }
+
+    size_t size() const { return _size; }
+
+    bool empty() const { return !_size; }
+
+    const char* begin() const { return _data; }
+
+    const char* end() const { return _data + _size; }
+
+    char operator[](size_t index) const { return _data[index]; }
+
+    std::string_view view() const { return std::string_view(_data, _size); }
+
+    /**
+     * @brief A view of {length} bytes from {offset} on, sharing this buffer. {length} is clamped to what is there.
+     * Throws std::out_of_range if {offset} is past the end.
+     *
+     */
+    Bytes slice(size_t offset, size_t length = SIZE_MAX) const {
+        if (offset > _size) {
+            throw std::out_of_range("Bytes::slice offset out of range");
+        }
+        Bytes part(*this);
+        part._data += offset;
+        part._size = std::min(length, _size - offset);
+        return part;
+    }
+
+    /**
+     * @brief Drop the first {count} bytes from this view, e.g. a parsed header. The buffer is untouched.
+     *
+     */
+    void remove_prefix(size_t count) {
+        count = std::min(count, _size);
+        _data += count;
+        _size -= count;
+    }
+
+    void remove_suffix(size_t count) { _size -= std::min(count, _size); }
+
+    /**
+     * @brief The number of views sharing the buffer, 0 for an empty Bytes. Only a hint while other threads hold views.
+     *
+     */
+    uint32_t use_count() const { return _storage ? _storage->refs.load(std::memory_order_relaxed) : 0; }
+
+    void swap(Bytes& other) noexcept {
+        std::swap(_storage, other._storage);
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+    }
+
+    friend bool operator==(const Bytes& lhs, const Bytes& rhs) { return lhs.view() == rhs.view(); }
+
+    friend bool operator!=(const Bytes& lhs, const Bytes& rhs) { return !(lhs == rhs); }
+
+private:
+    friend class BytesBuilder;
+
+    // Adopts one reference to {storage}.
+    Bytes(detail::BytesStorage* storage, const char* data, size_t size) : _storage(storage), _data(data), _size(size) {}
+
+private:
+    detail::BytesStorage* _storage;
+    const char* _data;
+    size_t _size;
+};
+
+/**
+ * @brief Writes a message into a buffer of its own and freezes it into a Bytes without copying, e.g. when reading
+ * from a socket or serializing.
+ *
+ *      BytesBuilder builder(4096);
+ *      ssize_t n = ::read(fd, builder.tail(), builder.tailroom());
+ *      builder.commit(n);
+ *      queue.push_back(builder.freeze());
+ */
+class BytesBuilder : public Noncopyable {
+public:
+    explicit BytesBuilder(size_t capacity = 0) : _storage(nullptr), _size(0) { reserve(capacity); }
+
+    ~BytesBuilder() {
+        if (_storage) {
+            _storage->release();
+        }
+    }
+
+    /**
+     * @brief Make room for at least {capacity} bytes in total, moving what was written so far if needed.
+     *
+     */
+    void reserve(size_t capacity) {
+        if (capacity <= this->capacity()) {
+            return;
+        }
+        detail::BytesStorage* storage = detail::BytesStorage::allocate(capacity);
+        if (_size) {
+            std::memcpy(storage->data(), _storage->data(), _size);
+        }
+        if (_storage) {
+            _storage->release();
+        }
+        _storage = storage;
+    }
+
+    void append(const void* data, size_t size) {
+        if (_size + size > capacity()) {
+            reserve(std::max(_size + size, capacity() * 2));
+        }
+        if (size) {
+            std::memcpy(_storage->data() + _size, data, size);
+        }
+        _size += size;
+    }
+
+    void append(std::string_view text) { append(text.data(), text.size()); }
+
+    /**
+     * @brief Where the next byte goes, for writing into the buffer directly; see tailroom() and commit().
+     *
+     */
+    char* tail() { return _storage ? _storage->data() + _size : nullptr; }
+
+    size_t tailroom() const { return capacity() - _size; }
+
+    /**
+     * @brief Count {size} bytes written at tail() as part of the message.
+     *
+     */
+    void commit(size_t size) { _size += std::min(size, tailroom()); }
+
+    char* data() { return _storage ? _storage->data() : nullptr; }
+
+    size_t size() const { return _size; }
+
+    size_t capacity() const { return _storage ? _storage->capacity : 0; }
+
+    /**
+     * @brief Hand the bytes written so far over to an immutable Bytes, without copying, and start over empty.
+     *
+     */
+    Bytes freeze() {
+        detail::BytesStorage* storage = _storage;
+        size_t size = _size;
+        _storage = nullptr;
+        _size = 0;
+        return storage ? Bytes(storage, storage->data(), size) : Bytes();
+    }
+
+private:
+    detail::BytesStorage* _storage;
+    size_t _size;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_BYTES_HPP
@@ -0,0 +1,104 @@
+/**
+ * @file cache_aligned.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Cache-line alignment utilities used to keep independently written data off a shared cache line.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_CACHE_ALIGNED_HPP
+#define CYBERTRON_BASE_CACHE_ALIGNED_HPP
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+namespace cybertron::base {
+/**
+ * @brief Minimum offset between two objects to avoid false sharing. Falls back to 64 bytes when the standard library
+ * does not provide std::hardware_destructive_interference_size (libstdc++ < 12, libc++).
+ *
+ */
+#if defined(__cpp_lib_hardware_interference_size)
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC warns that the value depends on -mtune; it is only used for layout, never as part of an ABI.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t hardware_destructive_interference_size = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+inline constexpr std::size_t hardware_destructive_interference_size = 64;
+#endif
+
+namespace detail {
+// True when {Args} is a single argument of type {Self}, so forwarding constructors can leave copies and moves alone.
+template <typename Self, typename... Args>
+inline constexpr bool is_self_v = false;
+
+template <typename Self, typename Arg>
+inline constexpr bool is_self_v<Self, Arg> = std::is_same_v<std::decay_t<Arg>, Self>;
+}  // namespace detail
+
+template <typename T>
+/**
+ * @brief Stores {T} at the start of its own cache line. sizeof(CacheAligned<T>) is rounded up to a multiple of the
+ * line size, so the next member never shares a line with it.
+ *
+ * #NOTE Only correct when the enclosing storage honours the alignment, i.e. members, stack objects and C++17 aligned
+ * new. Use Padded<T> for storage that may be under-aligned.
+ */
+class alignas(hardware_destructive_interference_size) CacheAligned {
+public:
+    template <typename... Args, typename = std::enable_if_t<!detail::is_self_v<CacheAligned, Args...>>>
+    explicit CacheAligned(Args&&... args) : _value(std::forward<Args>(args)...) {}
+
+    T& get() { return _value; }
+    const T& get() const { return _value; }
+
+    T& operator*() { return _value; }
+    const T& operator*() const { return _value; }
+
+    T* operator->() { return &_value; }
+    const T* operator->() const { return &_value; }
+
+private:
+    T _value;
+};
+
+template <typename T>
+/**
+ * @brief Surrounds {T} with a full cache line of padding on both sides, so it is isolated from its neighbours even when
+ * the storage is not line aligned.
+ *
+ */
+class Padded {
+public:
+    template <typename... Args, typename = std::enable_if_t<!detail::is_self_v<Padded, Args...>>>
+    explicit Padded(Args&&... args) : _value(std::forward<Args>(args)...) {}
+
+    T& get() { return _value; }
+    const T& get() const { return _value; }
+
+    T& operator*() { return _value; }
+    const T& operator*() const { return _value; }
+
+    T* operator->() { return &_value; }
+    const T* operator->() const { return &_value; }
+
+private:
+    char _pad_front[hardware_destructive_interference_size];
+    T _value;
+    char _pad_back[hardware_destructive_interference_size];
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_CACHE_ALIGNED_HPP
@@ -0,0 +1,241 @@
+/**
+ * @file channel.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A Go-style channel with unbuffered (rendezvous) and buffered modes.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_CHANNEL_HPP
+#define CYBERTRON_BASE_CHANNEL_HPP
+
+#include <mutex>
+#include <deque>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+
+namespace cybertron::base {
+template <typename T, typename LockPolicy = StdLockPolicy>
+/**
+ * @brief A channel in the sense of Go. Unlike BlockingQueue, {capacity} 0 does not mean unbounded but unbuffered:
+ * send() blocks until a receiver takes the element, which is moved straight from the sender into the receiver's
+ * output with no intermediate storage. With {capacity} > 0 the channel buffers up to that many elements and send()
+ * blocks only while the buffer is full.
+ *
+ * Blocked senders and receivers are served in FIFO order, each parked on a condition variable of its own, so a
+ * handoff wakes exactly the thread it is meant for. After close(), send() fails, while receive() still drains the
+ * buffer before it starts failing.
+ */
+class Channel : public Noncopyable {
+    // Whether elements can be sent by copy, which needs both copy construction into the buffer and copy assignment
+    // into a waiting receiver.
+    template <typename U>
+    static constexpr bool kCopyable = std::is_copy_constructible_v<U> && std::is_copy_assignable_v<U>;
+
+public:
+    using mutex_type = typename LockPolicy::mutex_type;
+    using condition_type = typename LockPolicy::condition_type;
+
+    explicit Channel(size_t capacity = 0)
+        : _capacity(capacity), _active(true), _mutex(), _buffer(), _senders(), _receivers() {}
+
+    ~Channel() { close(); }
+
+    /**
+     * @brief Close the channel and wake up every blocked sender and receiver, which then fail.
+     *
+     */
+    void close() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        _active = false;
+        for (Sender* sender : _senders) {
+            sender->cond.notify_one();
+        }
+        for (Receiver* receiver : _receivers) {
+            receiver->cond.notify_one();
+        }
+    }
+
+    /**
+     * @brief Send {element} within {timeout} microseconds in a blocking way. If the {timeout} parameter is set to 0,
+     * then it will wait until a receiver or buffer slot takes it or the channel is closed.
+     *
+     * @param element Input element that is going to be sent.
+     * @param timeout Timeout in microseconds.
+     * @return true if the element was handed to a receiver or buffered,
+     * @return false on timeout or if the channel is closed.
+     */
+    template <typename U = T, typename = std::enable_if_t<kCopyable<U>>>
+    bool send(const T& element, const int64_t& timeout = 0) {
+        return _send(&element, nullptr, true, timeout);
+    }
+
+    bool send(T&& element, const int64_t& timeout = 0) { return _send(nullptr, &element, true, timeout); }
+
+    /**
+     * @brief Send {element} only if a receiver is already waiting or the buffer has room.
+     *
+     * @return true if the element was sent, false otherwise.
+     */
+    template <typename U = T, typename = std::enable_if_t<kCopyable<U>>>
+    bool try_send(const T& element) {
+        return _send(&element, nullptr, false, 0);
+    }
+
+    bool try_send(T&& element) { return _send(nullptr, &element, false, 0); }
+
+    /**
+     * @brief Receive one element within {timeout} microseconds in a blocking way. If the {timeout} parameter is set to
+     * 0, then it will wait until an element arrives or the channel is closed and drained.
+     *
+     * @param element Output element.
+     * @param timeout Timeout in microseconds.
+     * @return true if one element was received,
+     * @return false on timeout or if the channel is closed and drained.
+     */
+    bool receive(T& element, const int64_t& timeout = 0) { return _receive(element, true, timeout); }
+
+    /**
+     * @brief Receive one element only if one is buffered or a sender is already waiting.
+     *
+     * @return true if one element was received, false otherwise.
+     */
+    bool try_receive(T& element) { return _receive(element, false, 0); }
+
+    size_t size() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _buffer.size();
+    }
+
+    size_t capacity() { return _capacity; }
+
+    bool closed() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return !_active;
+    }
+
+private:
+    // Parked senders point at the caller's element, so a receiver copies or moves it exactly once.
+    struct Sender {
+        const T* copy_from;
+        T* move_from;
+        bool done;
+        condition_type cond;
+    };
+
+    struct Receiver {
+        T* element;
+        bool done;
+        condition_type cond;
+    };
+
+    // The copy branches are only instantiated for copyable {T}, so move-only elements work with the T&& overloads. The
+    // const T& overloads, the only source of {copy_from}, do not exist for other types.
+    static void _assign(T& to, const T* copy_from, T* move_from) {
+        if constexpr (kCopyable<T>) {
+            if (!move_from) {
+                to = *copy_from;
+                return;
+            }
+        }
+        to = std::move(*move_from);
+    }
+
+    void _buffer_push(const T* copy_from, T* move_from) {
+        if constexpr (kCopyable<T>) {
+            if (!move_from) {
+                _buffer.push_back(*copy_from);
+                return;
+            }
+        }
+        _buffer.push_back(std::move(*move_from));
+    }
+
+    bool _send(const T* copy_from, T* move_from, bool block, const int64_t& timeout) {
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (!_active) {
+            return false;
+        }
+        if (!_receivers.empty()) {
+            Receiver* receiver = _receivers.front();
+            _receivers.pop_front();
+            _assign(*receiver->element, copy_from, move_from);
+            receiver->done = true;
+            receiver->cond.notify_one();
+            return true;
+        }
+        if (_buffer.size() < _capacity) {
+            _buffer_push(copy_from, move_from);
+            return true;
+        }
+        if (!block) {
+            return false;
+        }
+        Sender self{copy_from, move_from, false, {}};
+        _senders.push_back(&self);
+        detail::timed_wait(lock, self.cond, timeout, [&] { return self.done || (!_active); });
+        if (!self.done) {
+            _senders.erase(std::find(_senders.begin(), _senders.end(), &self));
+        }
+        return self.done;
+    }
+
+    bool _receive(T& element, bool block, const int64_t& timeout) {
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (!_buffer.empty()) {
+            element = std::move(_buffer.front());
+            _buffer.pop_front();
+            // Refill the freed slot from the oldest blocked sender. Once closed, blocked senders fail instead.
+            if (_active && (!_senders.empty())) {
+                Sender* sender = _senders.front();
+                _senders.pop_front();
+                _buffer_push(sender->copy_from, sender->move_from);
+                _complete(sender);
+            }
+            return true;
+        }
+        if (_active && (!_senders.empty())) {
+            Sender* sender = _senders.front();
+            _senders.pop_front();
+            _assign(element, sender->copy_from, sender->move_from);
+            _complete(sender);
+            return true;
+        }
+        if ((!_active) || (!block)) {
+            return false;
+        }
+        Receiver self{&element, false, {}};
+        _receivers.push_back(&self);
+        detail::timed_wait(lock, self.cond, timeout, [&] { return self.done || (!_active); });
+        if (!self.done) {
+            _receivers.erase(std::find(_receivers.begin(), _receivers.end(), &self));
+        }
+        return self.done;
+    }
+
+    static void _complete(Sender* sender) {
+        sender->done = true;
+        sender->cond.notify_one();
+    }
+
+private:
+    const size_t _capacity;
+    bool _active;  // guarded by _mutex
+    mutex_type _mutex;
+    std::deque<T> _buffer;             // guarded by _mutex
+    std::deque<Sender*> _senders;      // guarded by _mutex
+    std::deque<Receiver*> _receivers;  // guarded by _mutex
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_CHANNEL_HPP
@@ -0,0 +1,461 @@
+/**
+ * @file concurrent_hash_map.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A segmented open-addressing hash map with lock-free reads.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_CONCURRENT_HASH_MAP_HPP
+#define CYBERTRON_BASE_CONCURRENT_HASH_MAP_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "epoch.hpp"
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename LockPolicy = StdLockPolicy>
+/**
+ * @brief A concurrent hash map for tables that are read far more often than written, such as sessions or
+ * connections. Lookups take no lock and write nothing shared, only an EpochGuard; writers lock one of {segments}
+ * segments chosen by the hash of the key, so writes to different segments proceed in parallel.
+ *
+ * Every segment is an open-addressing table in the style of SwissTable: slots come in groups of eight, each with a
+ * 64-bit word of control bytes holding seven bits of the hash of its key, so a probe checks a whole group with a few
+ * integer instructions and only compares keys on a control byte match. Key and value live in an immutable entry that
+ * the slot points to: an update swaps in a new entry, and replaced or erased entries are retired to the EpochDomain.
+ *
+ * A segment that fills up grows to about twice the size, and the entries move over incrementally: the new table is
+ * published at once, and every later write to the segment moves a few groups of the old one before doing its own
+ * work, so no single write pays for the whole segment. Entry pointers are moved, never keys or values. Until the old
+ * table is drained, lookups probe it before the new one, and a lookup that raced with a resize simply retries.
+ *
+ * {V} must be copy constructible, since find() hands out copies.
+ */
+class ConcurrentHashMap : public Noncopyable {
+public:
+    using mutex_type = typename LockPolicy::mutex_type;
+
+    /**
+     * @brief Construct a new Concurrent Hash Map object.
+     *
+     * @param capacity The number of elements expected, to size the segments up front.
+     * @param segments The number of independently locked segments, rounded up to a power of two.
+     * @param domain The epoch domain protecting readers and retiring old entries and tables.
+     */
+    explicit ConcurrentHashMap(size_t capacity = 0, size_t segments = 16,
+                               EpochDomain& domain = EpochDomain::get_instance())
+        : _domain(domain), _hash(), _equal(), _segment_mask(_round_up(segments) - 1), _segments(_segment_mask + 1) {
+        size_t groups = _round_up(capacity * 2 / kGroupSize / (_segment_mask + 1));
+        for (auto& segment : _segments) {
+            segment->table.store(new Table(groups), std::memory_order_relaxed);
+        }
+    }
+
+    ~ConcurrentHashMap() {
+        for (auto& segment : _segments) {
+            for (Table* table : {segment->table.load(std::memory_order_relaxed),
+                                 segment->old.load(std::memory_order_relaxed)}) {
+                if (!table) {
+                    continue;
+                }
+                for (size_t i = 0; i < table->capacity(); ++i) {
+                    Entry* entry = table->slots[i].load(std::memory_order_relaxed);
+                    if (_live(entry)) {
+                        delete entry;
+                    }
+                }
+                delete table;
+            }
+        }
+    }
+
+    /**
+     * @brief Copy the value of {key} into {value}. Lock-free.
+     *
+     * @return true if the key was found.
+     */
+    bool find(const K& key, V& value) const { return find_with(key, [&](const V& found) { value = found; }); }
+
+    /**
+     * @brief Call reader(value) on the value of {key} in place, e.g. to read one field of a large value. The value
+     * must not be used after {reader} returns. Lock-free.
+     *
+     * @return true if the key was found.
+     */
+    template <typename Reader>
+    bool find_with(const K& key, Reader&& reader) const {
+        uint64_t hash = _hash_of(key);
+        const Segment& segment = _segment(hash);
+        EpochGuard guard(_domain);
+        for (;;) {
+            // Loaded in this order, {old} is never older than the table {table} is being filled from.
+            const Table* table = segment.table.load(std::memory_order_acquire);
+            const Table* old = segment.old.load(std::memory_order_acquire);
+            const Entry* entry = nullptr;
+            auto found = [&](size_t, const Entry* candidate) { entry = candidate; };
+            // An entry is stored in the new table before its old slot is marked moved, so this order cannot miss it.
+            if (old && old != table) {
+                _probe(*old, key, hash, found);
+            }
+            if (!entry) {
+                _probe(*table, key, hash, found);
+            }
+            if (entry) {
+                reader(entry->value);
+                return true;
+            }
+            // A resize that started meanwhile may have moved the key out of {table} behind the probe.
+            if (segment.table.load(std::memory_order_acquire) == table) {
+                return false;
+            }
+        }
+    }
+
+    bool contains(const K& key) const { return find_with(key, [](const V&) {}); }
+
+    /**
+     * @brief Insert {key} with {value} unless the key is present already.
+     *
+     * @return true if inserted, false if the key was present and nothing changed.
+     */
+    bool insert(K key, V value) { return _insert(std::move(key), std::move(value), false); }
+
+    /**
+     * @brief Insert {key} with {value}, replacing the value if the key is present already.
+     *
+     * @return true if inserted, false if assigned.
+     */
+    bool insert_or_assign(K key, V value) { return _insert(std::move(key), std::move(value), true); }
+
+    /**
+     * @brief Remove {key}.
+     *
+     * @return true if the key was present.
+     */
+    bool erase(const K& key) {
+        uint64_t hash = _hash_of(key);
+        Segment& segment = _segment(hash);
+        std::lock_guard<mutex_type> lock(segment.mutex);
+        _migrate(segment, kMigrateGroups);
+        _migrate_key(segment, key, hash);
+        Table* table = segment.table.load(std::memory_order_relaxed);
+        size_t index = kNotFound;
+        _probe(*table, key, hash, [&](size_t found, const Entry*) { index = found; });
+        if (index == kNotFound) {
+            return false;
+        }
+        // A reader may still match the old control byte; it then finds no entry, or an entry with another key.
+        _set_control(*table, index, kDeleted);
+        _domain.retire(table->slots[index].exchange(nullptr, std::memory_order_acq_rel));
+        segment.size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Remove every element. Not atomic across segments.
+     *
+     */
+    void clear() {
+        for (auto& segment : _segments) {
+            std::lock_guard<mutex_type> lock(segment->mutex);
+            Table* old = segment->old.load(std::memory_order_relaxed);
+            Table* table = segment->table.load(std::memory_order_relaxed);
+            segment->old.store(nullptr, std::memory_order_release);
+            segment->table.store(new Table(1), std::memory_order_release);
+            segment->size.store(0, std::memory_order_relaxed);
+            segment->used = 0;
+            segment->migrated = 0;
+            for (Table* retired : {table, old}) {
+                if (!retired) {
+                    continue;
+                }
+                for (size_t i = 0; i < retired->capacity(); ++i) {
+                    Entry* entry = retired->slots[i].load(std::memory_order_relaxed);
+                    if (_live(entry)) {
+                        _domain.retire(entry);
+                    }
+                }
+                _domain.retire(retired);
+            }
+        }
+    }
+
+    /**
+     * @brief The number of elements. Only a snapshot under concurrent writes.
+     *
+     */
+    size_t size() const {
+        size_t size = 0;
+        for (const auto& segment : _segments) {
+            size += segment->size.load(std::memory_order_relaxed);
+        }
+        return size;
+    }
+
+    bool empty() const { return !size(); }
+
+    size_t segments() const { return _segments.size(); }
+
+private:
+    static constexpr size_t kGroupSize = 8;
+    static constexpr size_t kNotFound = SIZE_MAX;
+    static constexpr size_t kMigrateGroups = 4;  // groups of the old table every write moves during a resize
+    static constexpr uint8_t kEmpty = 0x80;
+    static constexpr uint8_t kDeleted = 0xFE;
+    static constexpr uint64_t kLsbs = 0x0101010101010101ull;
+    static constexpr uint64_t kMsbs = 0x8080808080808080ull;
+
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    struct Table {
+        explicit Table(size_t groups)
+            : mask(groups - 1),
+              control(new std::atomic<uint64_t>[groups]),
+              slots(new std::atomic<Entry*>[groups * kGroupSize]) {
+            for (size_t i = 0; i < groups; ++i) {
+                control[i].store(kEmpty * kLsbs, std::memory_order_relaxed);
+            }
+            for (size_t i = 0; i < groups * kGroupSize; ++i) {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        size_t capacity() const { return (mask + 1) * kGroupSize; }
+
+        const size_t mask;  // the number of groups minus one
+        std::unique_ptr<std::atomic<uint64_t>[]> control;
+        std::unique_ptr<std::atomic<Entry*>[]> slots;
+    };
+
+    struct Segment {
+        mutex_type mutex;
+        std::atomic<Table*> table{nullptr};
+        std::atomic<Table*> old{nullptr};  // the table being moved into {table}, if a resize is in progress
+        std::atomic<size_t> size{0};
+        size_t used = 0;      // guarded by mutex, full and deleted slots of the table
+        size_t migrated = 0;  // guarded by mutex, groups of {old} moved so far
+    };
+
+    // Left in a slot of an old table whose entry was moved on. Never dereferenced.
+    static Entry* _moved() {
+        alignas(Entry) static char marker[sizeof(Entry)];
+        return reinterpret_cast<Entry*>(marker);
+    }
+
+    static bool _live(const Entry* entry) { return entry && entry != _moved(); }
+
+    static size_t _round_up(size_t size) {
+        size_t rounded = 1;
+        while (rounded < size) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    // Bytes of {word} equal to {byte} get their top bit set. Bytes above a true match may match falsely, which only
+    // costs a key comparison.
+    static uint64_t _match(uint64_t word, uint8_t byte) {
+        uint64_t diff = word ^ (kLsbs * byte);
+        return (diff - kLsbs) & ~diff & kMsbs;
+    }
+
+    // Only empty bytes have the top bit set and bit 1 clear.
+    static uint64_t _match_empty(uint64_t word) { return word & ~(word << 6) & kMsbs; }
+
+    static uint64_t _match_free(uint64_t word) { return word & kMsbs; }
+
+    static uint8_t _tag(uint64_t hash) { return static_cast<uint8_t>(hash & 0x7F); }
+
+    static size_t _byte_of(uint64_t bits) { return static_cast<size_t>(__builtin_ctzll(bits)) / 8; }
+
+    uint64_t _hash_of(const K& key) const {
+        uint64_t hash = static_cast<uint64_t>(_hash(key));
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    Segment& _segment(uint64_t hash) { return *_segments[(hash >> 40) & _segment_mask]; }
+
+    const Segment& _segment(uint64_t hash) const { return *_segments[(hash >> 40) & _segment_mask]; }
+
+    // Calls found(index, entry) for the slot holding {key}, if any. Groups are visited in triangular order, which
+    // covers the whole table, until one with an empty byte.
+    template <typename Found>
+    void _probe(const Table& table, const K& key, uint64_t hash, Found&& found) const {
+        uint8_t tag = _tag(hash);
+        size_t group = static_cast<size_t>(hash >> 7) & table.mask;
+        for (size_t step = 1; step <= table.mask + 1; ++step) {
+            uint64_t word = table.control[group].load(std::memory_order_acquire);
+            for (uint64_t bits = _match(word, tag); bits; bits &= bits - 1) {
+                size_t index = group * kGroupSize + _byte_of(bits);
+                const Entry* entry = table.slots[index].load(std::memory_order_acquire);
+                if (_live(entry) && _equal(entry->key, key)) {
+                    found(index, entry);
+                    return;
+                }
+            }
+            if (_match_empty(word)) {
+                return;
+            }
+            group = (group + step) & table.mask;
+        }
+    }
+
+    // Must hold the segment mutex. The first empty or deleted slot on the probe sequence of {hash}.
+    static size_t _free_slot(const Table& table, uint64_t hash) {
+        size_t group = static_cast<size_t>(hash >> 7) & table.mask;
+        for (size_t step = 1;; ++step) {
+            uint64_t bits = _match_free(table.control[group].load(std::memory_order_relaxed));
+            if (bits) {
+                return group * kGroupSize + _byte_of(bits);
+            }
+            group = (group + step) & table.mask;
+        }
+    }
+
+    // Must hold the segment mutex, the only writer of the control words.
+    static void _set_control(Table& table, size_t index, uint8_t byte) {
+        std::atomic<uint64_t>& control = table.control[index / kGroupSize];
+        size_t shift = (index % kGroupSize) * 8;
+        uint64_t word = control.load(std::memory_order_relaxed);
+        word = (word & ~(uint64_t(0xFF) << shift)) | (uint64_t(byte) << shift);
+        control.store(word, std::memory_order_release);
+    }
+
+    static uint8_t _control_of(const Table& table, size_t index) {
+        uint64_t word = table.control[index / kGroupSize].load(std::memory_order_relaxed);
+        return static_cast<uint8_t>(word >> ((index % kGroupSize) * 8));
+    }
+
+    bool _insert(K&& key, V&& value, bool assign) {
+        uint64_t hash = _hash_of(key);
+        Segment& segment = _segment(hash);
+        std::lock_guard<mutex_type> lock(segment.mutex);
+        _migrate(segment, kMigrateGroups);
+        _migrate_key(segment, key, hash);
+        Table* table = segment.table.load(std::memory_order_relaxed);
+        size_t index = kNotFound;
+        _probe(*table, key, hash, [&](size_t found, const Entry*) { index = found; });
+        if (index != kNotFound) {
+            if (assign) {
+                Entry* entry = new Entry{std::move(key), std::move(value)};
+                _domain.retire(table->slots[index].exchange(entry, std::memory_order_acq_rel));
+            }
+            return false;
+        }
+        // Keep at least one slot in eight empty so that probes stay short and always terminate.
+        if ((segment.used + 1) * 8 > table->capacity() * 7) {
+            table = _grow(segment, table);
+        }
+        _place(segment, *table, hash, new Entry{std::move(key), std::move(value)});
+        segment.size.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Must hold the segment mutex.
+    void _place(Segment& segment, Table& table, uint64_t hash, Entry* entry) {
+        size_t index = _free_slot(table, hash);
+        if (_control_of(table, index) == kEmpty) {
+            ++segment.used;
+        }
+        // The entry is stored before the control byte is released, so a reader matching the byte finds it.
+        table.slots[index].store(entry, std::memory_order_release);
+        _set_control(table, index, _tag(hash));
+    }
+
+    // Must hold the segment mutex. Publishes a table with room to grow and starts moving the entries of {table} into
+    // it; writes move the rest a few groups at a time. Sized so that those writes cannot fill it before it is done.
+    Table* _grow(Segment& segment, Table* table) {
+        // Only when a table filled up again before the last resize was done, which the sizing below rules out
+        // unless many keys were erased meanwhile.
+        _migrate(segment, SIZE_MAX);
+        size_t live = segment.size.load(std::memory_order_relaxed);
+        size_t steps = (table->mask + kMigrateGroups) / kMigrateGroups;
+        size_t slots = std::max(2 * (live + 1), (live + steps + 1) * 8 / 7 + 1);
+        Table* grown = new Table(_round_up(slots / kGroupSize + 1));
+        // Readers load the table before the old one, so they never pair {grown} with an older table than {table}.
+        segment.old.store(table, std::memory_order_release);
+        segment.table.store(grown, std::memory_order_release);
+        segment.used = 0;
+        segment.migrated = 0;
+        _migrate(segment, kMigrateGroups);
+        return grown;
+    }
+
+    // Must hold the segment mutex. Moves up to {groups} groups of the old table, retiring it once it is drained.
+    void _migrate(Segment& segment, size_t groups) {
+        Table* old = segment.old.load(std::memory_order_relaxed);
+        if (!old) {
+            return;
+        }
+        Table* table = segment.table.load(std::memory_order_relaxed);
+        size_t end = std::min(old->mask + 1, segment.migrated + std::min(groups, old->mask + 1));
+        for (; segment.migrated < end; ++segment.migrated) {
+            for (size_t i = 0; i < kGroupSize; ++i) {
+                _move(segment, *old, *table, segment.migrated * kGroupSize + i);
+            }
+        }
+        if (segment.migrated > old->mask) {
+            segment.old.store(nullptr, std::memory_order_release);
+            segment.migrated = 0;
+            _domain.retire(old);
+        }
+    }
+
+    // Must hold the segment mutex. Moves {key} out of the old table, if it is still there, so that writes only ever
+    // touch the new one.
+    void _migrate_key(Segment& segment, const K& key, uint64_t hash) {
+        Table* old = segment.old.load(std::memory_order_relaxed);
+        if (!old) {
+            return;
+        }
+        size_t index = kNotFound;
+        _probe(*old, key, hash, [&](size_t found, const Entry*) { index = found; });
+        if (index != kNotFound) {
+            _move(segment, *old, *segment.table.load(std::memory_order_relaxed), index);
+        }
+    }
+
+    // Must hold the segment mutex.
+    void _move(Segment& segment, Table& old, Table& table, size_t index) {
+        Entry* entry = old.slots[index].load(std::memory_order_relaxed);
+        if (!_live(entry)) {
+            return;
+        }
+        _place(segment, table, _hash_of(entry->key), entry);
+        // A reader that sees the marker finds the entry in the new table.
+        old.slots[index].store(_moved(), std::memory_order_release);
+    }
+
+private:
+    EpochDomain& _domain;
+    Hash _hash;
+    KeyEqual _equal;
+    const size_t _segment_mask;
+    std::vector<CacheAligned<Segment>> _segments;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_CONCURRENT_HASH_MAP_HPP
@@ -0,0 +1,222 @@
+/**
+ * @file conflating_queue.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A blocking queue that keeps only the latest value per key.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_CONFLATING_QUEUE_HPP
+#define CYBERTRON_BASE_CONFLATING_QUEUE_HPP
+
+#include <mutex>
+#include <deque>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+template <typename K, typename V, typename Hash = std::hash<K>, typename LockPolicy = StdLockPolicy>
+/**
+ * @brief A conflating queue for state-update streams: pushing a key that is already pending overwrites its value in
+ * place and keeps its position, so a consumer only ever sees the latest value of each key, in the order the keys first
+ * became pending. Keys are FIFO, values are last-writer-wins.
+ *
+ * {capacity_limit} counts distinct pending keys. An overwrite never needs room, so as long as the set of live keys
+ * fits, a bounded queue loses nothing but superseded values. Only a new key arriving at a full queue either blocks
+ * ({push_block}) or evicts the oldest pending key, like BlockingQueue.
+ * #NOTE Use it carefully when set the parameter {capacity_limit} to 0 because it may lead to unlimited memory
+ * consumption if the key space is unbounded.
+ */
+class ConflatingQueue : public Noncopyable {
+public:
+    using mutex_type = typename LockPolicy::mutex_type;
+    using condition_type = typename LockPolicy::condition_type;
+
+    /**
+     * @brief Construct a new Conflating Queue object.
+     *
+     * @param capacity_limit The maximum number of pending keys, 0 means unlimited.
+     * @param push_block Whether pushing a new key blocks while the queue is full, or evicts the oldest key.
+     */
+    explicit ConflatingQueue(size_t capacity_limit = 0, bool push_block = false)
+        : _push_block(push_block),
+          _active(true),
+          _capacity_limit(capacity_limit),
+          _conflated(0),
+          _mutex(),
+          _order(),
+          _values(),
+          _consumer(),
+          _producer() {}
+
+    ~ConflatingQueue() { close(); }
+
+    void close() {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _order.clear();
+            _values.clear();
+            _active = false;
+        }
+        _producer->notify_all();
+        _consumer->notify_all();
+    }
+
+    bool closed() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return !_active;
+    }
+
+    /**
+     * @brief Push {value} for {key} within {timeout} microseconds. If {key} is pending its value is replaced right
+     * away. Otherwise the key is appended, waiting for room in blocking mode, where a {timeout} of 0 waits until
+     * success or the queue is closed.
+     *
+     * @return true if the value was stored, false on timeout or if the queue is closed.
+     */
+    bool push(const K& key, V value, const int64_t& timeout = 0) { return _push(key, std::move(value), true, timeout); }
+
+    /**
+     * @brief Push {value} for {key} only if that is possible without blocking.
+     *
+     * @return true if the value was stored, false if the queue is full in blocking mode or closed.
+     */
+    bool try_push(const K& key, V value) { return _push(key, std::move(value), false, 0); }
+
+    /**
+     * @brief Pop the oldest pending key with its latest value within {timeout} microseconds in a blocking way. If the
+     * {timeout} parameter is set to 0, then it will always try to pop until success or the queue is closed.
+     *
+     * @return true if one key was popped, false on timeout or if the queue is closed.
+     */
+    bool pop(K& key, V& value, const int64_t& timeout = 0) { return _pop(key, value, true, timeout); }
+
+    bool try_pop(K& key, V& value) { return _pop(key, value, false, 0); }
+
+    /**
+     * @brief The number of pending keys.
+     *
+     */
+    size_t size() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _order.size();
+    }
+
+    size_t capacity() { return _capacity_limit; }
+
+    bool empty() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _order.empty();
+    }
+
+    bool full() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return !_has_room();
+    }
+
+    /**
+     * @brief How many values have been overwritten before anyone popped them, since construction.
+     *
+     */
+    uint64_t conflated() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _conflated;
+    }
+
+    void clear() {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _order.clear();
+            _values.clear();
+        }
+        _producer->notify_all();
+    }
+
+private:
+    bool _has_room() const { return (!_capacity_limit) || (_order.size() < _capacity_limit); }
+
+    bool _push(const K& key, V&& value, bool block, const int64_t& timeout) {
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (!_active) {
+            return false;
+        }
+        auto it = _values.find(key);
+        if (it != _values.end()) {
+            it->second = std::move(value);
+            ++_conflated;
+            return true;
+        }
+        if (_push_block && !_has_room()) {
+            if (!block) {
+                return false;
+            }
+            // The key may have become pending while we slept, then this is an overwrite after all.
+            if (!detail::timed_wait(lock, *_producer, timeout,
+                                    [&] { return (!_active) || _has_room() || _values.count(key); })) {
+                return false;
+            }
+            if (!_active) {
+                return false;
+            }
+            it = _values.find(key);
+            if (it != _values.end()) {
+                it->second = std::move(value);
+                ++_conflated;
+                return true;
+            }
+        }
+        while (!_has_room()) {
+            _values.erase(_order.front());
+            _order.pop_front();
+        }
+        _values.emplace(key, std::move(value));
+        _order.push_back(key);
+        _consumer->notify_one();
+        return true;
+    }
+
+    bool _pop(K& key, V& value, bool block, const int64_t& timeout) {
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (block &&
+            !detail::timed_wait(lock, *_consumer, timeout, [&] { return ((!_active) || (!_order.empty())); })) {
+            return false;
+        }
+        if ((!_active) || _order.empty()) {
+            return false;
+        }
+        auto it = _values.find(_order.front());
+        key = std::move(_order.front());
+        _order.pop_front();
+        value = std::move(it->second);
+        _values.erase(it);
+        if (_push_block) {
+            _producer->notify_one();
+        }
+        return true;
+    }
+
+private:
+    const bool _push_block;
+    bool _active;  // guarded by _mutex
+    const size_t _capacity_limit;
+    uint64_t _conflated;  // guarded by _mutex
+    mutex_type _mutex;
+    std::deque<K> _order;                    // guarded by _mutex, pending keys in arrival order
+    std::unordered_map<K, V, Hash> _values;  // guarded by _mutex, latest value of each pending key
+    CacheAligned<condition_type> _consumer;  // guarded by _mutex
+    CacheAligned<condition_type> _producer;  // guarded by _mutex
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_CONFLATING_QUEUE_HPP
@@ -0,0 +1,38 @@
+/**
+ * @file cpu_relax.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A spin-wait hint for busy loops.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_CPU_RELAX_HPP
+#define CYBERTRON_BASE_CPU_RELAX_HPP
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace cybertron::base {
+/**
+ * @brief Tell the core we are spinning, so it can yield pipeline resources to its sibling hyper-thread and avoid the
+ * memory-order mis-speculation penalty when the awaited cache line finally changes.
+ *
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    asm volatile("" ::: "memory");
+#endif
+}
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_CPU_RELAX_HPP
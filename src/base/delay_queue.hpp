@@ -0,0 +1,226 @@
+/**
+ * @file delay_queue.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A blocking queue whose elements become poppable at a scheduled time.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_DELAY_QUEUE_HPP
+#define CYBERTRON_BASE_DELAY_QUEUE_HPP
+
+#include <set>
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+#include "timing_wheel.hpp"
+
+namespace cybertron::base {
+template <typename T, typename LockPolicy = StdLockPolicy>
+/**
+ * @brief A delay queue: push() schedules an element for a steady_clock time and pop() hands it out once that time
+ * has come. Pending elements sit in a TimingWheel, so push() and cancel() are O(1) even with millions of them, and a
+ * consumer sleeps until the next possible expiry instead of waking up to re-check timestamps. A producer wakes a
+ * sleeping consumer only when it schedules something earlier than every sleeping consumer's wakeup, and a consumer
+ * that leaves hands pending elements over to another sleeper if none of them would wake up for them in time.
+ *
+ * Elements fire on the first tick boundary at or after their deadline, never before it.
+ */
+class DelayQueue : public Noncopyable {
+public:
+    using Clock = std::chrono::steady_clock;
+    using mutex_type = typename LockPolicy::mutex_type;
+    using condition_type = typename LockPolicy::condition_type;
+
+    /**
+     * @brief Construct a new Delay Queue object.
+     *
+     * @param tick The timer resolution.
+     */
+    explicit DelayQueue(Clock::duration tick = std::chrono::milliseconds(1))
+        : _active(true),
+          _mutex(),
+          _wheel(tick),
+          _ready(),
+          _wakeups(),
+          _consumer() {}
+
+    ~DelayQueue() { close(); }
+
+    /**
+     * @brief Close the queue, drop all elements and wake up every consumer.
+     *
+     */
+    void close() {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _active = false;
+            _ready.clear();
+            _wheel.clear();
+        }
+        _consumer.notify_all();
+    }
+
+    /**
+     * @brief Schedule {element} to become poppable at {when}.
+     *
+     * @return the id to cancel() it with, or a default TimerId if the queue is closed.
+     */
+    TimerId push(const T& element, const Clock::time_point& when) { return _push(element, when); }
+
+    TimerId push(T&& element, const Clock::time_point& when) { return _push(std::move(element), when); }
+
+    /**
+     * @brief Schedule {element} to become poppable {delay} from now.
+     *
+     */
+    template <typename Rep, typename Period>
+    TimerId push_after(T element, const std::chrono::duration<Rep, Period>& delay) {
+        return _push(std::move(element), Clock::now() + delay);
+    }
+
+    /**
+     * @brief Cancel a pending element in O(1).
+     *
+     * @return true if the element was pending and is now gone, false if it already became poppable or was cancelled.
+     */
+    bool cancel(const TimerId& id) {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _wheel.cancel(id);
+    }
+
+    /**
+     * @brief Pop the next due element within {timeout} microseconds in a blocking way. If the {timeout} parameter is
+     * set to 0, then it will wait until an element is due or the queue is closed.
+     *
+     * @param element Output element.
+     * @param timeout Timeout in microseconds.
+     * @return true if one due element was popped,
+     * @return false on timeout or if the queue is closed.
+     */
+    bool pop(T& element, const int64_t& timeout = 0) {
+        Clock::time_point deadline = timeout ? Clock::now() + std::chrono::microseconds(timeout) : Clock::time_point::max();
+        std::unique_lock<mutex_type> lock(_mutex);
+        for (;;) {
+            if (!_active) {
+                return false;
+            }
+            Clock::time_point now = Clock::now();
+            _collect(now);
+            if (!_ready.empty()) {
+                element = std::move(_ready.front());
+                _ready.pop_front();
+                _hand_over();
+                return true;
+            }
+            if (now >= deadline) {
+                _hand_over();
+                return false;
+            }
+            Clock::time_point wakeup = deadline;
+            Clock::time_point expiry;
+            if (_wheel.next_expiry(expiry) && expiry < wakeup) {
+                wakeup = expiry;
+            }
+            _sleep(lock, wakeup);
+        }
+    }
+
+    /**
+     * @brief Pop an element only if one is due right now.
+     *
+     */
+    bool try_pop(T& element) {
+        std::lock_guard<mutex_type> lock(_mutex);
+        if (!_active) {
+            return false;
+        }
+        _collect(Clock::now());
+        if (_ready.empty()) {
+            return false;
+        }
+        element = std::move(_ready.front());
+        _ready.pop_front();
+        return true;
+    }
+
+    /**
+     * @brief The number of elements, pending and due.
+     *
+     */
+    size_t size() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _wheel.size() + _ready.size();
+    }
+
+    bool empty() { return !size(); }
+
+private:
+    template <typename U>
+    TimerId _push(U&& element, const Clock::time_point& when) {
+        bool wake = false;
+        TimerId id;
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            if (!_active) {
+                return id;
+            }
+            id = _wheel.schedule(std::forward<U>(element), when);
+            wake = !_wakeups.empty() && when < *_wakeups.begin();
+        }
+        if (wake) {
+            _consumer.notify_one();
+        }
+        return id;
+    }
+
+    // Must hold _mutex.
+    void _collect(const Clock::time_point& now) {
+        _wheel.advance(now, [this](T&& element) { _ready.push_back(std::move(element)); });
+    }
+
+    // Must hold _mutex. Sleeps until {wakeup}, an earlier push() or close(); the caller re-evaluates afterwards.
+    void _sleep(std::unique_lock<mutex_type>& lock, const Clock::time_point& wakeup) {
+        auto slot = _wakeups.insert(wakeup);
+        if (wakeup == Clock::time_point::max()) {
+            _consumer.wait(lock);
+        } else {
+            _consumer.wait_until(lock, wakeup);
+        }
+        _wakeups.erase(slot);
+    }
+
+    // Must hold _mutex. Called by a consumer on its way out of pop(). push() skipped the wakeup for anything due after
+    // the earliest sleeper's wakeup, counting on that sleeper; if the leaving consumer was it, or it leaves due
+    // elements behind, another sleeper has to re-evaluate.
+    void _hand_over() {
+        if (_wakeups.empty()) {
+            return;
+        }
+        Clock::time_point expiry;
+        if (!_ready.empty() || (_wheel.next_expiry(expiry) && expiry < *_wakeups.begin())) {
+            _consumer.notify_one();
+        }
+    }
+
+private:
+    bool _active;  // guarded by _mutex
+    mutex_type _mutex;
+    TimingWheel<T> _wheel;                      // guarded by _mutex
+    std::deque<T> _ready;                       // guarded by _mutex
+    std::multiset<Clock::time_point> _wakeups;  // of the sleeping consumers, guarded by _mutex
+    condition_type _consumer;                   // guarded by _mutex
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_DELAY_QUEUE_HPP
@@ -0,0 +1,222 @@
+/**
+ * @file epoch.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Epoch-based memory reclamation for lock-free structures.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_EPOCH_HPP
+#define CYBERTRON_BASE_EPOCH_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "singleton.hpp"
+#include "noncopyable.hpp"
+#include "reclamation.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief An epoch-based reclamation domain. Readers of a lock-free structure stay inside a critical section, opened by
+ * an EpochGuard, while they hold pointers into it; writers retire() what they unlink instead of deleting it, and an
+ * object is deleted only after every critical section that might have seen it has ended. A critical section costs two
+ * stores to a thread-local record and a fence, with no per-pointer work, which makes epochs the cheap choice for
+ * read-mostly structures. A reader stuck inside a critical section stalls all reclamation, though; see
+ * HazardPointerDomain for a bounded alternative.
+ *
+ * The global epoch only advances once every thread inside a critical section has caught up with it. Each thread keeps
+ * what it retires in three buckets by epoch, and a bucket is reclaimed when the epoch has moved on by two.
+ *
+ * EpochDomain::get_instance() is the process-wide domain. A domain must outlive the critical sections and the
+ * retired objects of all its threads; destroying it deletes whatever is still retired.
+ */
+class EpochDomain : public Singleton<EpochDomain> {
+public:
+    /**
+     * @brief Construct a new Epoch Domain object.
+     *
+     * @param collect_threshold A thread tries to advance the epoch and reclaim every so many retire() calls.
+     */
+    explicit EpochDomain(size_t collect_threshold = 64)
+        : _collect_threshold(collect_threshold ? collect_threshold : 1), _epoch(), _registry() {
+        _epoch->store(1, std::memory_order_relaxed);
+    }
+
+    ~EpochDomain() {
+        _registry.for_each([](Record& record) {
+            for (Bucket& bucket : record.buckets) {
+                _reclaim(bucket);
+            }
+        });
+    }
+
+    /**
+     * @brief Enter a critical section on the calling thread. Critical sections nest. Prefer EpochGuard.
+     *
+     */
+    void enter() {
+        Record* record = _registry.local();
+        if (!record->depth++) {
+            record->state.store((_epoch->load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+            // The announcement must be visible before any pointer of the structure is read.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void leave() {
+        Record* record = _registry.local();
+        if (!--record->depth) {
+            record->state.store(0, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Delete {pointer} once no critical section can still see it. It must already be unreachable for new
+     * readers. May be called inside or outside a critical section.
+     *
+     */
+    template <typename T>
+    void retire(T* pointer) {
+        retire(pointer, &detail::delete_retired<T>);
+    }
+
+    /**
+     * @brief Same as retire(), but reclaims {pointer} with deleter(pointer).
+     *
+     */
+    void retire(void* pointer, void (*deleter)(void*)) {
+        Record* record = _registry.local();
+        uint64_t epoch = _epoch->load(std::memory_order_seq_cst);
+        Bucket& bucket = record->buckets[epoch % kBuckets];
+        if (bucket.epoch != epoch) {
+            // What is left in this bucket is at least three epochs old.
+            _reclaim(bucket);
+            bucket.epoch = epoch;
+        }
+        bucket.retired.push_back({pointer, deleter});
+        if (++record->retires >= _collect_threshold) {
+            record->retires = 0;
+            try_advance();
+            _collect(*record);
+        }
+    }
+
+    /**
+     * @brief Advance the global epoch if every thread inside a critical section has observed the current one.
+     *
+     * @return true if the epoch moved on, by this call or a concurrent one.
+     */
+    bool try_advance() {
+        uint64_t epoch = _epoch->load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool behind = false;
+        _registry.for_each([&](Record& record) {
+            uint64_t state = record.state.load(std::memory_order_acquire);
+            behind = behind || ((state & 1) && (state >> 1) != epoch);
+        });
+        if (behind) {
+            return false;
+        }
+        _epoch->compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    /**
+     * @brief Reclaim what the calling thread retired and no reader can see any more.
+     *
+     */
+    void collect() {
+        try_advance();
+        _collect(*_registry.local());
+    }
+
+    /**
+     * @brief Wait until every critical section that was open at the call has ended, then reclaim what the calling
+     * thread retired before. Must not be called inside a critical section.
+     *
+     */
+    void synchronize() {
+        uint64_t target = _epoch->load(std::memory_order_seq_cst) + 2;
+        while (_epoch->load(std::memory_order_acquire) < target) {
+            if (!try_advance()) {
+                std::this_thread::yield();
+            }
+        }
+        _collect(*_registry.local());
+    }
+
+    /**
+     * @brief Whether the calling thread is inside a critical section of this domain.
+     *
+     */
+    bool in_critical_section() { return _registry.local()->depth > 0; }
+
+    uint64_t epoch() const { return _epoch->load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t kBuckets = 3;
+
+    struct Bucket {
+        uint64_t epoch = 0;
+        std::vector<detail::Retired> retired;
+    };
+
+    struct alignas(hardware_destructive_interference_size) Record : detail::RegistryRecord {
+        std::atomic<uint64_t> state{0};  // (epoch << 1) | 1 inside a critical section, 0 outside
+        // Owner thread only.
+        size_t depth = 0;
+        size_t retires = 0;
+        Bucket buckets[kBuckets];
+    };
+
+    static void _reclaim(Bucket& bucket) {
+        // Deleters may retire more objects, so take the list out first.
+        std::vector<detail::Retired> retired;
+        retired.swap(bucket.retired);
+        for (const detail::Retired& object : retired) {
+            object.reclaim();
+        }
+    }
+
+    void _collect(Record& record) {
+        uint64_t epoch = _epoch->load(std::memory_order_seq_cst);
+        for (Bucket& bucket : record.buckets) {
+            if (bucket.epoch + 2 <= epoch) {
+                _reclaim(bucket);
+            }
+        }
+    }
+
+private:
+    const size_t _collect_threshold;
+    CacheAligned<std::atomic<uint64_t>> _epoch;
+    detail::RecordRegistry<Record> _registry;
+};
+
+/**
+ * @brief Keeps the calling thread inside a critical section of {domain} for its lifetime.
+ *
+ *      EpochGuard guard;
+ *      Node* node = head.load(std::memory_order_acquire);  // safe to use until the guard goes away
+ */
+class EpochGuard : public Noncopyable {
+public:
+    explicit EpochGuard(EpochDomain& domain = EpochDomain::get_instance()) : _domain(domain) { _domain.enter(); }
+
+    ~EpochGuard() { _domain.leave(); }
+
+private:
+    EpochDomain& _domain;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_EPOCH_HPP
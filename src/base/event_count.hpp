@@ -0,0 +1,118 @@
+/**
+ * @file event_count.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief An event count built directly on futex(2). #NOTE This only works on Linux.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_EVENT_COUNT_HPP
+#define CYBERTRON_BASE_EVENT_COUNT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#include "futex.hpp"
+#include "cpu_relax.hpp"
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief A condition-variable-like primitive for lock-free code. A waiter takes a key, re-checks its condition and
+ * only then sleeps on the key; a notifier changes the condition and then calls notify(). Wakeups cannot be lost in
+ * between.
+ *
+ *      auto key = event.prepare_wait();
+ *      if (ready()) { event.cancel_wait(); return; }
+ *      event.wait(key);
+ *
+ * Waiters spin for a short while before they register themselves, and notify() only enters the kernel when somebody
+ * is registered, so a handoff to a spinning waiter costs no system call at all.
+ */
+class EventCount : public Noncopyable {
+public:
+    using Key = uint32_t;
+
+    EventCount() : _epoch(0), _waiters(0) {}
+
+    Key prepare_wait() {
+        // seq_cst puts this read in the single total order with the epoch bump of notify(), and keeps the caller's
+        // condition check after it. If that check misses an update, the read came before the matching notify(), so the
+        // epoch moves on from {key} and wait() will not sleep through it. An acquire load would give neither.
+        return _epoch.load(std::memory_order_seq_cst);
+    }
+
+    void cancel_wait() {}
+
+    /**
+     * @brief Block until a notify() newer than {key} happens. May return spuriously.
+     *
+     */
+    void wait(Key key) {
+        if (_spin(key)) {
+            return;
+        }
+        _waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (_epoch.load(std::memory_order_seq_cst) == key) {
+            detail::futex_wait(&_epoch, key);
+        }
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Same as wait(), but gives up at {deadline}.
+     *
+     * @return false if the deadline passed without a notification, true otherwise.
+     */
+    bool wait_until(Key key, const std::chrono::steady_clock::time_point& deadline) {
+        if (_spin(key)) {
+            return true;
+        }
+        _waiters.fetch_add(1, std::memory_order_seq_cst);
+        bool in_time = true;
+        if (_epoch.load(std::memory_order_seq_cst) == key) {
+            in_time = detail::futex_wait_until(&_epoch, key, deadline);
+        }
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+        return in_time || _epoch.load(std::memory_order_relaxed) != key;
+    }
+
+    void notify() { _notify(1); }
+
+    void notify_all() { _notify(INT_MAX); }
+
+private:
+    static constexpr int kSpinCount = 128;
+
+    bool _spin(Key key) {
+        for (int i = 0; i < kSpinCount; ++i) {
+            if (_epoch.load(std::memory_order_acquire) != key) {
+                return true;
+            }
+            cpu_relax();
+        }
+        return false;
+    }
+
+    void _notify(int count) {
+        // The bump releases the caller's condition update; seq_cst pairs it with the waiter registration in wait().
+        _epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_seq_cst)) {
+            detail::futex_wake(&_epoch, count);
+        }
+    }
+
+private:
+    std::atomic<uint32_t> _epoch;
+    std::atomic<uint32_t> _waiters;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_EVENT_COUNT_HPP
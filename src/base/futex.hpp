@@ -0,0 +1,86 @@
+/**
+ * @file futex.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Thin wrappers around the Linux futex(2) system call. #NOTE This only works on Linux.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_FUTEX_HPP
+#define CYBERTRON_BASE_FUTEX_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <type_traits>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cybertron::base::detail {
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex word must be lock free");
+
+inline uint32_t* futex_word(std::atomic<uint32_t>* address) { return reinterpret_cast<uint32_t*>(address); }
+
+/**
+ * @brief Sleep while {*address} equals {expected}. Returns early on a wake, a signal or a value mismatch, so callers
+ * must always re-check their condition.
+ *
+ */
+inline void futex_wait(std::atomic<uint32_t>* address, uint32_t expected) {
+    syscall(SYS_futex, futex_word(address), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief Same as futex_wait(), but gives up at the absolute steady_clock {deadline}.
+ *
+ * @return false if the deadline has passed, true otherwise (which includes spurious returns).
+ */
+inline bool futex_wait_until(std::atomic<uint32_t>* address, uint32_t expected,
+                             const std::chrono::steady_clock::time_point& deadline) {
+    // FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC timeout, which is what steady_clock reads on Linux. Using it
+    // avoids re-arming a relative timeout after every spurious wakeup.
+    auto since_epoch = deadline.time_since_epoch();
+    if (since_epoch.count() < 0) {
+        return false;
+    }
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(seconds.count());
+    ts.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds).count());
+    syscall(SYS_futex, futex_word(address), FUTEX_WAIT_BITSET_PRIVATE, expected, &ts, nullptr, FUTEX_BITSET_MATCH_ANY);
+    return std::chrono::steady_clock::now() < deadline;
+}
+
+/**
+ * @brief Translate a deadline on any clock into a steady_clock one, so it can be handed to futex_wait_until().
+ *
+ */
+template <typename Clock, typename Duration>
+std::chrono::steady_clock::time_point to_steady_deadline(const std::chrono::time_point<Clock, Duration>& deadline) {
+    if constexpr (std::is_same_v<Clock, std::chrono::steady_clock>) {
+        return std::chrono::time_point_cast<std::chrono::steady_clock::duration>(deadline);
+    } else {
+        return std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(deadline - Clock::now());
+    }
+}
+
+/**
+ * @brief Wake up to {count} threads sleeping on {address}.
+ *
+ */
+inline void futex_wake(std::atomic<uint32_t>* address, int count) {
+    syscall(SYS_futex, futex_word(address), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+}  // namespace cybertron::base::detail
+#endif  // CYBERTRON_BASE_FUTEX_HPP
@@ -0,0 +1,189 @@
+/**
+ * @file hazard_pointer.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Hazard pointers for memory reclamation in lock-free structures.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_HAZARD_POINTER_HPP
+#define CYBERTRON_BASE_HAZARD_POINTER_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "singleton.hpp"
+#include "noncopyable.hpp"
+#include "reclamation.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief A hazard pointer domain. A reader publishes every pointer it is about to dereference in a HazardPointer;
+ * writers retire() what they unlink, and a retired object is deleted only once no hazard pointer holds it. Unlike
+ * epochs, a stalled reader only pins the few objects it protects, so the memory waiting for reclamation stays bounded,
+ * at the price of a fence per protected pointer.
+ *
+ * Each thread collects what it retires in a list of its own and scans all hazard pointers once the list has grown past
+ * the threshold, which amortizes a scan over many objects.
+ *
+ * HazardPointerDomain::get_instance() is the process-wide domain. A domain must outlive its hazard pointers and the
+ * retired objects of all its threads; destroying it deletes whatever is still retired.
+ */
+class HazardPointerDomain : public Singleton<HazardPointerDomain> {
+public:
+    /**
+     * @brief Construct a new Hazard Pointer Domain object.
+     *
+     * @param scan_threshold A thread scans the hazard pointers once it has retired this many objects, and at least
+     * twice the number of hazard pointers.
+     */
+    explicit HazardPointerDomain(size_t scan_threshold = 64)
+        : _scan_threshold(scan_threshold ? scan_threshold : 1), _hazards(0), _slots(), _lists() {}
+
+    ~HazardPointerDomain() {
+        _lists.for_each([](RetireList& list) {
+            for (const detail::Retired& object : list.retired) {
+                object.reclaim();
+            }
+        });
+    }
+
+    /**
+     * @brief Delete {pointer} once no hazard pointer protects it. It must already be unreachable for new readers.
+     *
+     */
+    template <typename T>
+    void retire(T* pointer) {
+        retire(pointer, &detail::delete_retired<T>);
+    }
+
+    /**
+     * @brief Same as retire(), but reclaims {pointer} with deleter(pointer).
+     *
+     */
+    void retire(void* pointer, void (*deleter)(void*)) {
+        RetireList* list = _lists.local();
+        list->retired.push_back({pointer, deleter});
+        if (list->retired.size() >= std::max(_scan_threshold, 2 * _hazards.load(std::memory_order_relaxed))) {
+            _scan(*list);
+        }
+    }
+
+    /**
+     * @brief Reclaim what the calling thread retired and no hazard pointer protects any more.
+     *
+     */
+    void collect() { _scan(*_lists.local()); }
+
+private:
+    friend class HazardPointer;
+
+    struct alignas(hardware_destructive_interference_size) Slot : detail::RegistryRecord {
+        std::atomic<const void*> pointer{nullptr};
+    };
+
+    struct RetireList : detail::RegistryRecord {
+        std::vector<detail::Retired> retired;  // owner thread only
+    };
+
+    Slot* _acquire_slot() {
+        Slot* slot = _slots.claim();
+        _hazards.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    void _release_slot(Slot* slot) {
+        slot->pointer.store(nullptr, std::memory_order_release);
+        _hazards.fetch_sub(1, std::memory_order_relaxed);
+        slot->in_use.store(false, std::memory_order_release);
+    }
+
+    void _scan(RetireList& list) {
+        // Pairs with the fence in HazardPointer::protect(): a reader either published its pointer before this reads
+        // the slots, or it re-reads the source afterwards and finds the object already unlinked.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::vector<const void*> hazards;
+        _slots.for_each([&](Slot& slot) {
+            if (const void* pointer = slot.pointer.load(std::memory_order_acquire)) {
+                hazards.push_back(pointer);
+            }
+        });
+        std::sort(hazards.begin(), hazards.end());
+        std::vector<detail::Retired> retired;
+        retired.swap(list.retired);
+        for (const detail::Retired& object : retired) {
+            if (std::binary_search(hazards.begin(), hazards.end(), static_cast<const void*>(object.pointer))) {
+                list.retired.push_back(object);
+            } else {
+                object.reclaim();
+            }
+        }
+    }
+
+private:
+    const size_t _scan_threshold;
+    std::atomic<size_t> _hazards;  // the number of hazard pointers alive
+    detail::RecordRegistry<Slot> _slots;
+    detail::RecordRegistry<RetireList> _lists;
+};
+
+/**
+ * @brief A single hazard pointer, owned by one thread at a time. It protects at most one object; use several to hold
+ * several objects, e.g. the current and the next node while walking a list.
+ *
+ *      HazardPointer hazard;
+ *      Node* node = hazard.protect(head);  // safe to use until reset() or the hazard pointer goes away
+ */
+class HazardPointer : public Noncopyable {
+public:
+    explicit HazardPointer(HazardPointerDomain& domain = HazardPointerDomain::get_instance())
+        : _domain(domain), _slot(domain._acquire_slot()) {}
+
+    ~HazardPointer() { _domain._release_slot(_slot); }
+
+    /**
+     * @brief Load {source} and protect the object it points to, retrying until the protection is known to have been
+     * published before the object could be retired.
+     *
+     * @return the protected pointer, which may be nullptr.
+     */
+    template <typename T>
+    T* protect(const std::atomic<T*>& source) {
+        T* pointer = source.load(std::memory_order_relaxed);
+        for (;;) {
+            _slot->pointer.store(pointer, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            T* current = source.load(std::memory_order_acquire);
+            if (current == pointer) {
+                return pointer;
+            }
+            pointer = current;
+        }
+    }
+
+    /**
+     * @brief Protect {pointer} directly. The caller must make sure it is still reachable after this, as protect() does.
+     *
+     */
+    void reset(const void* pointer = nullptr) {
+        _slot->pointer.store(pointer, std::memory_order_release);
+        if (pointer) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+private:
+    HazardPointerDomain& _domain;
+    HazardPointerDomain::Slot* _slot;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_HAZARD_POINTER_HPP
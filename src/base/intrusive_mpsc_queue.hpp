@@ -0,0 +1,179 @@
+/**
+ * @file intrusive_mpsc_queue.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief An unbounded lock-free multi-producer single-consumer queue of intrusively linked nodes.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_INTRUSIVE_MPSC_QUEUE_HPP
+#define CYBERTRON_BASE_INTRUSIVE_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+
+#include "cpu_relax.hpp"
+#include "noncopyable.hpp"
+#include "event_count.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief The link hook of an IntrusiveMpscQueue element. Derive the element type from it; a node can sit in one such
+ * queue at a time.
+ *
+ */
+struct MpscNode {
+    std::atomic<MpscNode*> mpsc_next{nullptr};
+};
+
+template <typename T>
+/**
+ * @brief Dmitry Vyukov's intrusive MPSC queue: elements carry their own link, so push() allocates nothing and costs a
+ * single atomic exchange, and pop() takes no lock either. This is the injection queue for executors and actors, where
+ * BlockingQueue would put every task into a deque slot under a mutex.
+ *
+ * The queue only links the nodes and never owns them: a node must stay alive from push() until it is popped, and
+ * whoever pops it takes it over. Any number of threads may push, but only one thread may pop at a time.
+ *
+ * A push() that races with pop() can leave the queue briefly unable to hand out its last nodes until the push
+ * finishes; try_pop() then returns nullptr, and pop() spins over the gap.
+ */
+class IntrusiveMpscQueue : public Noncopyable {
+    static_assert(std::is_base_of_v<MpscNode, T>, "T must derive from MpscNode");
+
+public:
+    IntrusiveMpscQueue() : _active(true), _waiting(false), _head(), _stub(), _tail(&*_stub), _readable() {
+        _head->store(&*_stub, std::memory_order_relaxed);
+    }
+
+    ~IntrusiveMpscQueue() { close(); }
+
+    /**
+     * @brief Stop accepting nodes and wake up the consumer. Nodes pushed before can still be popped.
+     *
+     */
+    void close() {
+        _active.store(false, std::memory_order_seq_cst);
+        _readable.notify_all();
+    }
+
+    bool closed() const { return !_active.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Append {node}, never blocking. May be called from any thread.
+     *
+     * @return true if the node was pushed, false if the queue is closed and {node} is still the caller's.
+     */
+    bool push(T* node) {
+        if (!_active.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        _link(node);
+        // Pairs with the store in pop(): either the consumer sees the node, or this sees it waiting.
+        if (_waiting.load(std::memory_order_seq_cst)) {
+            _readable.notify();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest node if one can be taken right now. Consumer only.
+     *
+     */
+    T* try_pop() {
+        MpscNode* tail = _tail;
+        MpscNode* next = tail->mpsc_next.load(std::memory_order_acquire);
+        if (tail == &*_stub) {
+            if (!next) {
+                return nullptr;
+            }
+            _tail = next;
+            tail = next;
+            next = next->mpsc_next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            _tail = next;
+            return static_cast<T*>(tail);
+        }
+        if (tail != _head->load(std::memory_order_acquire)) {
+            // A producer has swapped the head but not linked its node yet.
+            return nullptr;
+        }
+        // {tail} is the last node; put the stub behind it so that it can be unlinked.
+        _link(&*_stub);
+        next = tail->mpsc_next.load(std::memory_order_acquire);
+        if (next) {
+            _tail = next;
+            return static_cast<T*>(tail);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Take the oldest node within {timeout} microseconds in a blocking way. If the {timeout} parameter is set
+     * to 0, then it will wait until a node arrives or the queue is closed. Consumer only.
+     *
+     * @return the node, or nullptr on timeout or once the queue is closed and drained.
+     */
+    T* pop(const int64_t& timeout = 0) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+        for (;;) {
+            if (T* node = try_pop()) {
+                return node;
+            }
+            if (!_idle()) {
+                cpu_relax();
+                continue;
+            }
+            EventCount::Key key = _readable.prepare_wait();
+            _waiting.store(true, std::memory_order_seq_cst);
+            bool idle = _idle();
+            bool expired = false;
+            if (idle && _active.load(std::memory_order_seq_cst)) {
+                if (!timeout) {
+                    _readable.wait(key);
+                } else {
+                    expired = !_readable.wait_until(key, deadline);
+                }
+            }
+            _waiting.store(false, std::memory_order_relaxed);
+            if (expired || (idle && (!_active.load(std::memory_order_acquire)))) {
+                return try_pop();
+            }
+        }
+    }
+
+    /**
+     * @brief Whether nothing has been pushed that was not popped yet. Consumer only.
+     *
+     */
+    bool empty() const { return _idle(); }
+
+private:
+    void _link(MpscNode* node) {
+        node->mpsc_next.store(nullptr, std::memory_order_relaxed);
+        MpscNode* prev = _head->exchange(node, std::memory_order_seq_cst);
+        prev->mpsc_next.store(node, std::memory_order_release);
+    }
+
+    // Nothing pushed, not even halfway: the consumer is at the stub and no producer has swapped the head since.
+    bool _idle() const { return _tail == &*_stub && _head->load(std::memory_order_seq_cst) == &*_stub; }
+
+private:
+    std::atomic<bool> _active;
+    std::atomic<bool> _waiting;                  // the consumer is about to sleep
+    CacheAligned<std::atomic<MpscNode*>> _head;  // the newest node, swapped by producers
+    CacheAligned<MpscNode> _stub;
+    MpscNode* _tail;  // consumer only, the oldest node
+    EventCount _readable;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_INTRUSIVE_MPSC_QUEUE_HPP
@@ -0,0 +1,141 @@
+/**
+ * @file lock_policy.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Locking policies that select the mutex and condition variable used by the blocking containers.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_LOCK_POLICY_HPP
+#define CYBERTRON_BASE_LOCK_POLICY_HPP
+
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include <condition_variable>
+
+#include "mutex.hpp"
+#include "rw_lock.hpp"
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief std::mutex and std::condition_variable, the portable default.
+ *
+ */
+struct StdLockPolicy {
+    using mutex_type = std::mutex;
+    using condition_type = std::condition_variable;
+};
+
+/**
+ * @brief cybertron::base::Mutex and ConditionVariable. At most one futex syscall per handoff under contention, none
+ * when the waiter is still spinning. #NOTE This only works on Linux.
+ *
+ */
+struct FutexLockPolicy {
+    using mutex_type = Mutex;
+    using condition_type = ConditionVariable;
+};
+
+/**
+ * @brief RwSpinLock and ConditionVariable. Read-only accessors of the containers, such as size(), take the lock
+ * shared, so they run in parallel with each other. Exclusive sections spin, so keep them short. #NOTE This only works
+ * on Linux.
+ *
+ */
+struct RwSpinLockPolicy {
+    using mutex_type = RwSpinLock;
+    using condition_type = ConditionVariable;
+};
+
+/**
+ * @brief DistributedRwLock and ConditionVariable. Read-only accessors never contend with each other across cores, at
+ * the price of more expensive pushes and pops. #NOTE This only works on Linux.
+ *
+ */
+struct DistributedRwLockPolicy {
+    using mutex_type = DistributedRwLock;
+    using condition_type = ConditionVariable;
+};
+
+namespace detail {
+/**
+ * @brief Whether {Mutex} can also be locked shared, through lock_shared() and unlock_shared().
+ *
+ */
+template <typename Mutex, typename = void>
+struct is_shared_lockable : std::false_type {};
+
+template <typename Mutex>
+struct is_shared_lockable<Mutex, std::void_t<decltype(std::declval<Mutex&>().lock_shared()),
+                                             decltype(std::declval<Mutex&>().unlock_shared())>> : std::true_type {};
+
+/**
+ * @brief Holds {Mutex} shared if it supports that and exclusively otherwise, for read-only accessors.
+ *
+ */
+template <typename Mutex>
+class ReadLock : public Noncopyable {
+public:
+    explicit ReadLock(Mutex& mutex) : _mutex(mutex) {
+        if constexpr (is_shared_lockable<Mutex>::value) {
+            _mutex.lock_shared();
+        } else {
+            _mutex.lock();
+        }
+    }
+
+    ~ReadLock() {
+        if constexpr (is_shared_lockable<Mutex>::value) {
+            _mutex.unlock_shared();
+        } else {
+            _mutex.unlock();
+        }
+    }
+
+private:
+    Mutex& _mutex;
+};
+
+/**
+ * @brief Wait on {condition} until {predicate} holds, at most {timeout} microseconds, 0 means forever. This is the
+ * timeout convention shared by all blocking containers in base.
+ *
+ * @return the final value of {predicate}.
+ */
+template <typename Lock, typename Condition, typename Predicate>
+bool timed_wait(Lock& lock, Condition& condition, const int64_t& timeout, Predicate predicate) {
+    if (timeout) {
+        return condition.wait_for(lock, std::chrono::microseconds(timeout), predicate);
+    }
+    condition.wait(lock, predicate);
+    return true;
+}
+
+/**
+ * @brief Wait on {condition} until {predicate} holds or the absolute {deadline} passes. A deadline of
+ * time_point::max() means forever. Unlike re-arming a relative timeout, looping on this does not drift.
+ *
+ * @return the final value of {predicate}.
+ */
+template <typename Lock, typename Condition, typename Clock, typename Duration, typename Predicate>
+bool deadline_wait(Lock& lock, Condition& condition, const std::chrono::time_point<Clock, Duration>& deadline,
+                   Predicate predicate) {
+    if (deadline == std::chrono::time_point<Clock, Duration>::max()) {
+        condition.wait(lock, predicate);
+        return true;
+    }
+    return condition.wait_until(lock, deadline, predicate);
+}
+
+}  // namespace detail
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_LOCK_POLICY_HPP
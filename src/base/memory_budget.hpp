@@ -0,0 +1,163 @@
+/**
+ * @file memory_budget.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A byte budget shared by queues, with a process-wide instance.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_MEMORY_BUDGET_HPP
+#define CYBERTRON_BASE_MEMORY_BUDGET_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+
+#include "singleton.hpp"
+#include "wait_list.hpp"
+#include "lock_policy.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief A pool of bytes that queues charge their elements against, so memory held in queues is accounted for and
+ * bounded across the whole process: once the budget is spent, blocking producers wait for any queue to release bytes
+ * and non-blocking ones shed their own oldest elements, long before the OOM killer steps in.
+ *
+ * MemoryBudget::get_instance() is the process-wide budget, unlimited until set_limit() is called. Separate instances
+ * can be created to budget a group of queues on their own. See BlockingQueue::set_byte_capacity().
+ */
+class MemoryBudget : public Singleton<MemoryBudget> {
+public:
+    using Waiter = WaitList<std::condition_variable>::Waiter;
+
+    /**
+     * @brief Construct a new Memory Budget object.
+     *
+     * @param limit The number of bytes that may be held at once, 0 means unlimited.
+     */
+    explicit MemoryBudget(size_t limit = 0) : _limit(limit), _used(0), _waiters(0), _mutex(), _released() {}
+
+    /**
+     * @brief Change the limit. Lowering it below what is in use does not take anything back, it only makes further
+     * acquisitions wait until enough has been released.
+     *
+     */
+    void set_limit(size_t limit) {
+        _limit.store(limit, std::memory_order_seq_cst);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _released.notify_all();
+    }
+
+    size_t limit() { return _limit.load(std::memory_order_relaxed); }
+
+    size_t used() { return _used.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Take {bytes} from the budget if they are available right now.
+     *
+     * @return true if the bytes were taken and must be release()d later, false otherwise.
+     */
+    bool try_acquire(size_t bytes) { return _take(bytes); }
+
+    /**
+     * @brief Whether {bytes} could be taken once a holder of {held} of the used bytes gave all of them back, i.e.
+     * whether shedding them is worth trying. Other holders may change the answer right after.
+     *
+     */
+    bool fits_without(size_t bytes, size_t held) {
+        size_t limit = _limit.load(std::memory_order_relaxed);
+        size_t others = _used.load(std::memory_order_relaxed) - held;
+        return (!limit) || (!others) || others + bytes <= limit;
+    }
+
+    /**
+     * @brief Take {bytes} from the budget within {timeout} microseconds in a blocking way. If the {timeout} parameter
+     * is set to 0, then it will wait until enough bytes are released.
+     *
+     * @return true if the bytes were taken and must be release()d later, false on timeout.
+     */
+    bool acquire(size_t bytes, const int64_t& timeout = 0) {
+        return acquire_with(bytes, [&](std::unique_lock<std::mutex>& lock, auto& list, auto predicate) {
+            return detail::timed_wait(lock, list, timeout, predicate);
+        });
+    }
+
+    /**
+     * @brief Take {bytes} from the budget, blocking through {wait}, which is called as wait(lock, list, predicate) with
+     * the WaitList of the budget and must return the final value of predicate like detail::timed_wait does. This lets a
+     * queue wait for the budget under its own deadline or cancellation.
+     *
+     * @return true if the bytes were taken and must be release()d later, false if {wait} gave up.
+     */
+    template <typename Waiter>
+    bool acquire_with(size_t bytes, Waiter&& wait) {
+        if (_take(bytes)) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        // Announce the waiter before looking at the budget again: a release() either sees it and notifies, or has
+        // returned its bytes before the predicate looks.
+        _waiters.fetch_add(1, std::memory_order_seq_cst);
+        bool taken = false;
+        wait(lock, _released, [&] { return taken || (taken = _take(bytes)); });
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+        return taken;
+    }
+
+    /**
+     * @brief Give back {bytes} taken earlier and wake up whoever waits for them. Only takes the lock when someone
+     * does, so the pops of independent queues do not serialize on the budget.
+     *
+     */
+    void release(size_t bytes) {
+        if (!bytes) {
+            return;
+        }
+        _used.fetch_sub(bytes, std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _released.notify_all();
+        }
+    }
+
+    /**
+     * @brief Wake up the one waiter parked on {waiter} to re-check its own exit conditions, e.g. after a stop request.
+     * Does nothing if it is not waiting.
+     *
+     */
+    void wake(Waiter& waiter) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _released.notify(waiter);
+    }
+
+private:
+    // A request larger than the whole budget is granted once nothing else is held, otherwise it could never be
+    // satisfied.
+    bool _take(size_t bytes) {
+        size_t limit = _limit.load(std::memory_order_seq_cst);
+        size_t used = _used.load(std::memory_order_seq_cst);
+        do {
+            if (limit && used && used + bytes > limit) {
+                return false;
+            }
+        } while (!_used.compare_exchange_weak(used, used + bytes, std::memory_order_seq_cst));
+        return true;
+    }
+
+private:
+    std::atomic<size_t> _limit;
+    std::atomic<size_t> _used;
+    std::atomic<size_t> _waiters;  // threads inside acquire_with() past the lock-free attempt
+    std::mutex _mutex;
+    WaitList<std::condition_variable> _released;  // guarded by _mutex
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_MEMORY_BUDGET_HPP
@@ -0,0 +1,338 @@
+/**
+ * @file multicast_ring.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A Disruptor-style single-writer ring buffer that every consumer reads in full.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_MULTICAST_RING_HPP
+#define CYBERTRON_BASE_MULTICAST_RING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "noncopyable.hpp"
+#include "event_count.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+template <typename T>
+/**
+ * @brief A multicast ring buffer in the style of the LMAX Disruptor: one writer publishes events into a preallocated
+ * ring and every consumer reads every event in place, each tracking its own sequence. Broadcasting to K consumers
+ * costs one write and no copies or locks, instead of K pushes into K queues.
+ *
+ * A consumer may depend on others and then only sees an event after all of them have released it, which builds
+ * pipelines and diamonds over a single ring (e.g. journal and replicate, then apply). The writer never overwrites an
+ * event that a consumer has not released yet, so the slowest consumer applies backpressure. Waiting spins briefly and
+ * then sleeps on an EventCount. Publishing and releasing only touch an EventCount while someone waits on it, so a ring
+ * whose consumers keep up costs the writer no shared write beyond its cursor.
+ *
+ * Register every consumer before the first publish(). {T} must be default constructible; slots are reused, so
+ * publish_with() can fill an event in place without allocating.
+ */
+class MulticastRing : public Noncopyable {
+public:
+    /**
+     * @brief A reader of the ring. Each consumer is driven by a single thread.
+     *
+     */
+    class Consumer : public Noncopyable {
+    public:
+        /**
+         * @brief Wait within {timeout} microseconds until events are available to this consumer: published, and
+         * released by every consumer it depends on. If the {timeout} parameter is set to 0, then it will wait until
+         * that happens or the ring is closed. After close() the events already published are still delivered.
+         *
+         * @return how many events from next() on can be read, 0 on timeout or once the ring is closed and drained. It
+         * only refreshes its view of the shared sequences once the previously reported batch is used up.
+         */
+        size_t wait(const int64_t& timeout = 0) {
+            uint64_t next = _sequence->load(std::memory_order_relaxed);
+            if (_cached_available > next) {
+                return static_cast<size_t>(_cached_available - next);
+            }
+            _cached_available = _available();
+            if (_cached_available > next) {
+                return static_cast<size_t>(_cached_available - next);
+            }
+            // Pairs with the fences in publish_with() and release(): either this sees their sequence, or they see it
+            // waiting and notify.
+            _ring._waiting_consumers->fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            size_t count = _wait(next, timeout);
+            _ring._waiting_consumers->fetch_sub(1, std::memory_order_relaxed);
+            return count;
+        }
+
+        /**
+         * @brief The sequence number of the first event this consumer has not released yet.
+         *
+         */
+        uint64_t next() const { return _sequence->load(std::memory_order_relaxed); }
+
+        /**
+         * @brief The event with {sequence}, which must be within what wait() reported.
+         *
+         */
+        const T& operator[](uint64_t sequence) const { return _ring._slots[sequence & _ring._mask]; }
+
+        /**
+         * @brief Mark the next {count} events as processed, letting dependent consumers and the writer move on.
+         *
+         */
+        void release(size_t count) {
+            _sequence->store(_sequence->load(std::memory_order_relaxed) + count, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_ring._waiting_writer->load(std::memory_order_relaxed)) {
+                _ring._released.notify_all();
+            }
+            if (_has_dependents && _ring._waiting_consumers->load(std::memory_order_relaxed)) {
+                _ring._published.notify_all();
+            }
+        }
+
+        /**
+         * @brief Wait for events like wait(), hand each one to {handler} as handler(event, sequence) and release them
+         * as a batch.
+         *
+         * @return the number of events handled.
+         */
+        template <typename Handler>
+        size_t consume(Handler&& handler, const int64_t& timeout = 0) {
+            size_t count = wait(timeout);
+            uint64_t next = _sequence->load(std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                handler((*this)[next + i], next + i);
+            }
+            if (count) {
+                release(count);
+            }
+            return count;
+        }
+
+    private:
+        friend class MulticastRing;
+
+        Consumer(MulticastRing& ring, std::vector<const Consumer*> dependencies, uint64_t start)
+            : _ring(ring),
+              _dependencies(std::move(dependencies)),
+              _has_dependents(false),
+              _cached_available(start),
+              _sequence() {
+            _sequence->store(start, std::memory_order_relaxed);
+        }
+
+        size_t _wait(uint64_t next, const int64_t& timeout) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+            for (;;) {
+                EventCount::Key key = _ring._published.prepare_wait();
+                _cached_available = _available();
+                if (_cached_available > next) {
+                    return static_cast<size_t>(_cached_available - next);
+                }
+                // A closed ring is drained only once everything published got here; dependencies may still be
+                // working through the rest and will wake this consumer as they release it.
+                if ((!_ring._active.load(std::memory_order_acquire)) &&
+                    _ring._cursor->load(std::memory_order_acquire) <= next) {
+                    return 0;
+                }
+                if (!timeout) {
+                    _ring._published.wait(key);
+                } else if (!_ring._published.wait_until(key, deadline)) {
+                    _cached_available = _available();
+                    return _cached_available > next ? static_cast<size_t>(_cached_available - next) : 0;
+                }
+            }
+        }
+
+        // Everything published and released by all dependencies.
+        uint64_t _available() const {
+            uint64_t available = _ring._cursor->load(std::memory_order_acquire);
+            for (const Consumer* dependency : _dependencies) {
+                available = std::min(available, dependency->_sequence->load(std::memory_order_acquire));
+            }
+            return available;
+        }
+
+    private:
+        MulticastRing& _ring;
+        const std::vector<const Consumer*> _dependencies;
+        bool _has_dependents;
+        uint64_t _cached_available;                    // owner thread only, saves re-reading shared sequences
+        CacheAligned<std::atomic<uint64_t>> _sequence;  // the number of events released
+    };
+
+    /**
+     * @brief Construct a new Multicast Ring object.
+     *
+     * @param capacity The number of slots, rounded up to a power of two.
+     */
+    explicit MulticastRing(size_t capacity)
+        : _mask(_round_up(capacity) - 1),
+          _slots(_mask + 1),
+          _active(true),
+          _cached_gate(0),
+          _consumers(),
+          _gating(),
+          _cursor(),
+          _waiting_consumers(),
+          _waiting_writer(),
+          _published(),
+          _released() {
+        _cursor->store(0, std::memory_order_relaxed);
+        _waiting_consumers->store(0, std::memory_order_relaxed);
+        _waiting_writer->store(false, std::memory_order_relaxed);
+    }
+
+    ~MulticastRing() { close(); }
+
+    /**
+     * @brief Register a consumer that reads every event after all of {dependencies} have released it. Must be called
+     * before the first publish().
+     *
+     * @return the consumer, owned by the ring.
+     */
+    Consumer& add_consumer(const std::vector<Consumer*>& dependencies = {}) {
+        for (Consumer* dependency : dependencies) {
+            dependency->_has_dependents = true;
+            _gating.erase(std::remove(_gating.begin(), _gating.end(), dependency), _gating.end());
+        }
+        std::vector<const Consumer*> gates(dependencies.begin(), dependencies.end());
+        _consumers.emplace_back(new Consumer(*this, std::move(gates), _cursor->load(std::memory_order_relaxed)));
+        _gating.push_back(_consumers.back().get());
+        return *_consumers.back();
+    }
+
+    /**
+     * @brief Publish {value} as the next event within {timeout} microseconds, blocking while the slowest consumer is a
+     * whole ring behind. If the {timeout} parameter is set to 0, then it will wait until success or the ring is closed.
+     *
+     * @return true if the event was published, false on timeout or if the ring is closed.
+     */
+    template <typename U>
+    bool publish(U&& value, const int64_t& timeout = 0) {
+        return publish_with([&](T& slot) { slot = std::forward<U>(value); }, timeout);
+    }
+
+    /**
+     * @brief Same as publish(), but lets {fill} write the event into its slot in place, as fill(T&).
+     *
+     */
+    template <typename Fill>
+    bool publish_with(Fill&& fill, const int64_t& timeout = 0) {
+        uint64_t sequence = _cursor->load(std::memory_order_relaxed);
+        if (!_claim(sequence, timeout)) {
+            return false;
+        }
+        fill(_slots[sequence & _mask]);
+        _cursor->store(sequence + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiting_consumers->load(std::memory_order_relaxed)) {
+            _published.notify_all();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stop publishing and wake up everyone. Consumers still receive the events published before.
+     *
+     */
+    void close() {
+        _active.store(false, std::memory_order_release);
+        _published.notify_all();
+        _released.notify_all();
+    }
+
+    /**
+     * @brief The number of events published so far, i.e. the sequence number of the next one.
+     *
+     */
+    uint64_t cursor() const { return _cursor->load(std::memory_order_acquire); }
+
+    size_t capacity() const { return _slots.size(); }
+
+private:
+    static size_t _round_up(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    // Only consumers at the end of a dependency chain can be the slowest, so the writer gates on those alone.
+    uint64_t _gate() const {
+        uint64_t gate = UINT64_MAX;
+        for (const Consumer* consumer : _gating) {
+            gate = std::min(gate, consumer->_sequence->load(std::memory_order_acquire));
+        }
+        return gate;
+    }
+
+    bool _claim(uint64_t sequence, const int64_t& timeout) {
+        if (!_active.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (_gating.empty() || sequence < _cached_gate + _slots.size()) {
+            return true;
+        }
+        _cached_gate = _gate();
+        if (sequence < _cached_gate + _slots.size()) {
+            return true;
+        }
+        // Pairs with the fence in Consumer::release().
+        _waiting_writer->store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool claimed = _wait_for_slot(sequence, timeout);
+        _waiting_writer->store(false, std::memory_order_relaxed);
+        return claimed;
+    }
+
+    bool _wait_for_slot(uint64_t sequence, const int64_t& timeout) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+        for (;;) {
+            EventCount::Key key = _released.prepare_wait();
+            _cached_gate = _gate();
+            if (sequence < _cached_gate + _slots.size()) {
+                return true;
+            }
+            if (!_active.load(std::memory_order_acquire)) {
+                return false;
+            }
+            if (!timeout) {
+                _released.wait(key);
+            } else if (!_released.wait_until(key, deadline)) {
+                _cached_gate = _gate();
+                return sequence < _cached_gate + _slots.size();
+            }
+        }
+    }
+
+private:
+    const size_t _mask;
+    std::vector<T> _slots;
+    std::atomic<bool> _active;
+    uint64_t _cached_gate;  // writer only
+    std::vector<std::unique_ptr<Consumer>> _consumers;
+    std::vector<const Consumer*> _gating;                    // consumers nobody depends on
+    CacheAligned<std::atomic<uint64_t>> _cursor;             // the number of events published
+    CacheAligned<std::atomic<uint32_t>> _waiting_consumers;  // consumers about to sleep on _published
+    CacheAligned<std::atomic<bool>> _waiting_writer;         // the writer is about to sleep on _released
+    EventCount _published;                                   // consumers wait here for the cursor or their dependencies
+    EventCount _released;                                    // the writer waits here for the slowest consumer
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_MULTICAST_RING_HPP
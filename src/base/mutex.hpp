@@ -0,0 +1,150 @@
+/**
+ * @file mutex.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief An adaptive spin-then-futex mutex and a matching condition variable. #NOTE This only works on Linux.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_MUTEX_HPP
+#define CYBERTRON_BASE_MUTEX_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <condition_variable>
+
+#include "futex.hpp"
+#include "cpu_relax.hpp"
+#include "noncopyable.hpp"
+#include "event_count.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief A mutex whose uncontended lock() and unlock() are a single atomic operation each. Under contention it spins
+ * for a short while before parking in the kernel, and unlock() only issues a futex wake when somebody is parked.
+ * Satisfies the standard Lockable requirements, so std::lock_guard / std::unique_lock work as usual.
+ *
+ */
+class Mutex : public Noncopyable {
+public:
+    Mutex() : _state(kUnlocked) {}
+
+    void lock() {
+        uint32_t expected = kUnlocked;
+        if (!_state.compare_exchange_strong(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed)) {
+            _lock_slow();
+        }
+    }
+
+    bool try_lock() {
+        uint32_t expected = kUnlocked;
+        return _state.compare_exchange_strong(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        if (_state.exchange(kUnlocked, std::memory_order_release) == kContended) {
+            detail::futex_wake(&_state, 1);
+        }
+    }
+
+private:
+    static constexpr uint32_t kUnlocked = 0;
+    static constexpr uint32_t kLocked = 1;
+    static constexpr uint32_t kContended = 2;  // locked and there may be sleepers
+    static constexpr int kSpinCount = 100;
+
+    void _lock_slow() {
+        for (int i = 0; i < kSpinCount; ++i) {
+            uint32_t state = _state.load(std::memory_order_relaxed);
+            if (state == kContended) {
+                break;  // Somebody is already parked, queue up behind them instead of burning the core.
+            }
+            if (state == kUnlocked &&
+                _state.compare_exchange_weak(state, kLocked, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+            cpu_relax();
+        }
+        // Once we have been asleep we cannot know whether others still are, so always leave the state contended.
+        while (_state.exchange(kContended, std::memory_order_acquire) != kUnlocked) {
+            detail::futex_wait(&_state, kContended);
+        }
+    }
+
+private:
+    std::atomic<uint32_t> _state;
+};
+
+/**
+ * @brief A condition variable that works with any lock type, in particular std::unique_lock<Mutex>. It shares the
+ * interface of std::condition_variable. Built on EventCount, so notify_one() / notify_all() are free when nobody is
+ * waiting and a waiter that is still spinning is handed over without any system call.
+ *
+ */
+class ConditionVariable : public Noncopyable {
+public:
+    ConditionVariable() : _event() {}
+
+    template <typename Lock>
+    void wait(Lock& lock) {
+        EventCount::Key key = _event.prepare_wait();
+        lock.unlock();
+        _event.wait(key);
+        lock.lock();
+    }
+
+    template <typename Lock, typename Predicate>
+    void wait(Lock& lock, Predicate predicate) {
+        while (!predicate()) {
+            wait(lock);
+        }
+    }
+
+    template <typename Lock, typename Clock, typename Duration>
+    std::cv_status wait_until(Lock& lock, const std::chrono::time_point<Clock, Duration>& deadline) {
+        EventCount::Key key = _event.prepare_wait();
+        lock.unlock();
+        bool in_time = _event.wait_until(key, detail::to_steady_deadline(deadline));
+        lock.lock();
+        return in_time ? std::cv_status::no_timeout : std::cv_status::timeout;
+    }
+
+    template <typename Lock, typename Clock, typename Duration, typename Predicate>
+    bool wait_until(Lock& lock, const std::chrono::time_point<Clock, Duration>& deadline, Predicate predicate) {
+        auto steady_deadline = detail::to_steady_deadline(deadline);
+        while (!predicate()) {
+            if (wait_until(lock, steady_deadline) == std::cv_status::timeout) {
+                return predicate();
+            }
+        }
+        return true;
+    }
+
+    template <typename Lock, typename Rep, typename Period>
+    std::cv_status wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout) {
+        return wait_until(lock, std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Lock, typename Rep, typename Period, typename Predicate>
+    bool wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout, Predicate predicate) {
+        return wait_until(lock, std::chrono::steady_clock::now() + timeout, std::move(predicate));
+    }
+
+    void notify_one() { _event.notify(); }
+
+    void notify_all() { _event.notify_all(); }
+
+private:
+    EventCount _event;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_MUTEX_HPP
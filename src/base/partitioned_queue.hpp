@@ -0,0 +1,248 @@
+/**
+ * @file partitioned_queue.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A blocking queue split into key-hashed lanes, keeping per-key order with parallel consumers.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_PARTITIONED_QUEUE_HPP
+#define CYBERTRON_BASE_PARTITIONED_QUEUE_HPP
+
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+template <typename K, typename T, typename Hash = std::hash<K>, typename LockPolicy = StdLockPolicy>
+/**
+ * @brief A queue partitioned into {lanes} FIFO lanes by the hash of a key, where each lane is held by at most one
+ * consumer at a time. Elements of one key therefore are processed one after another in push order, while elements of
+ * keys in different lanes are processed in parallel by any number of consumers.
+ *
+ * A consumer pop()s an element together with its lane, which it then holds until it calls release(lane) after
+ * processing the element; only then can the next element of that lane be popped, by any consumer. Lanes with work
+ * are handed out round-robin in the order they became ready, so one busy key cannot starve the others.
+ *
+ * {capacity_limit} bounds every lane on its own. When a lane is full, push() blocks in {push_block} mode and drops
+ * the oldest element of that lane otherwise, like BlockingQueue.
+ */
+class PartitionedQueue : public Noncopyable {
+public:
+    using mutex_type = typename LockPolicy::mutex_type;
+    using condition_type = typename LockPolicy::condition_type;
+
+    /**
+     * @brief Construct a new Partitioned Queue object.
+     *
+     * @param lanes The number of lanes, i.e. the maximum useful number of consumers.
+     * @param capacity_limit The capacity limit of each lane, 0 means unlimited.
+     * @param push_block Whether push() blocks while the lane of the key is full, or drops its oldest element.
+     */
+    explicit PartitionedQueue(size_t lanes, size_t capacity_limit = 0, bool push_block = false)
+        : _push_block(push_block),
+          _active(true),
+          _capacity_limit(capacity_limit),
+          _size(0),
+          _hash(),
+          _mutex(),
+          _lanes(lanes ? lanes : 1),
+          _ready(),
+          _consumer() {}
+
+    ~PartitionedQueue() { close(); }
+
+    /**
+     * @brief Close the queue, drop all elements and wake up every waiter.
+     *
+     */
+    void close() {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _active = false;
+            for (Lane& lane : _lanes) {
+                lane.elements.clear();
+                lane.producer.notify_all();
+            }
+            _ready.clear();
+            _size = 0;
+        }
+        _consumer->notify_all();
+    }
+
+    bool closed() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return !_active;
+    }
+
+    /**
+     * @brief Push {element} to the back of the lane of {key} within {timeout} microseconds. If the {timeout} parameter
+     * is set to 0, then a blocking push waits until success or the queue is closed.
+     *
+     * @return true if the element was pushed, false on timeout or if the queue is closed.
+     */
+    bool push(const K& key, T element, const int64_t& timeout = 0) {
+        return _push(lane_of(key), std::move(element), true, timeout);
+    }
+
+    /**
+     * @brief Push {element} only if that is possible without blocking.
+     *
+     * @return true if the element was pushed, false if its lane is full in blocking mode or the queue is closed.
+     */
+    bool try_push(const K& key, T element) { return _push(lane_of(key), std::move(element), false, 0); }
+
+    /**
+     * @brief Pop the front element of the next ready lane within {timeout} microseconds in a blocking way and hold
+     * that lane. If the {timeout} parameter is set to 0, then it will wait until success or the queue is closed.
+     *
+     * @param element Output element.
+     * @param lane Output lane, to be passed to release() once {element} is processed.
+     * @param timeout Timeout in microseconds.
+     * @return true if one element was popped, false on timeout or if the queue is closed.
+     */
+    bool pop(T& element, size_t& lane, const int64_t& timeout = 0) { return _pop(element, lane, true, timeout); }
+
+    bool try_pop(T& element, size_t& lane) { return _pop(element, lane, false, 0); }
+
+    /**
+     * @brief Give up a lane held since pop(), making its next element available to any consumer.
+     *
+     * @return true if {lane} was held and is released now, false if it is out of range or not held, e.g. released
+     * twice, in which case nothing changes.
+     */
+    bool release(size_t lane) {
+        bool wake = false;
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            if ((lane >= _lanes.size()) || (!_lanes[lane].claimed)) {
+                return false;
+            }
+            _lanes[lane].claimed = false;
+            wake = _make_ready(lane);
+        }
+        if (wake) {
+            _consumer->notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief The lane elements of {key} go to.
+     *
+     */
+    size_t lane_of(const K& key) const { return _hash(key) % _lanes.size(); }
+
+    size_t lanes() const { return _lanes.size(); }
+
+    /**
+     * @brief The total number of elements in all lanes, not counting popped ones whose lane is still held.
+     *
+     */
+    size_t size() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _size;
+    }
+
+    bool empty() { return !size(); }
+
+    size_t capacity() { return _capacity_limit; }
+
+private:
+    struct Lane {
+        std::deque<T> elements;
+        bool claimed = false;  // held by a consumer
+        bool ready = false;    // listed in _ready
+        condition_type producer;
+    };
+
+    bool _has_room(const Lane& lane) const { return (!_capacity_limit) || (lane.elements.size() < _capacity_limit); }
+
+    // Must hold _mutex. Lists {lane} as ready if it has work and nobody holds it.
+    bool _make_ready(size_t lane) {
+        Lane& candidate = _lanes[lane];
+        if (candidate.claimed || candidate.ready || candidate.elements.empty() || (!_active)) {
+            return false;
+        }
+        candidate.ready = true;
+        _ready.push_back(lane);
+        return true;
+    }
+
+    bool _push(size_t index, T&& element, bool block, const int64_t& timeout) {
+        bool wake = false;
+        {
+            std::unique_lock<mutex_type> lock(_mutex);
+            Lane& lane = _lanes[index];
+            if (_push_block && !_has_room(lane)) {
+                if ((!block) ||
+                    !detail::timed_wait(lock, lane.producer, timeout, [&] { return (!_active) || _has_room(lane); })) {
+                    return false;
+                }
+            }
+            if (!_active) {
+                return false;
+            }
+            if (!_has_room(lane)) {
+                lane.elements.pop_front();
+                --_size;
+            }
+            lane.elements.push_back(std::move(element));
+            ++_size;
+            wake = _make_ready(index);
+        }
+        if (wake) {
+            _consumer->notify_one();
+        }
+        return true;
+    }
+
+    bool _pop(T& element, size_t& index, bool block, const int64_t& timeout) {
+        std::unique_lock<mutex_type> lock(_mutex);
+        if (block &&
+            !detail::timed_wait(lock, *_consumer, timeout, [&] { return (!_active) || (!_ready.empty()); })) {
+            return false;
+        }
+        if ((!_active) || _ready.empty()) {
+            return false;
+        }
+        index = _ready.front();
+        _ready.pop_front();
+        Lane& lane = _lanes[index];
+        lane.ready = false;
+        lane.claimed = true;
+        element = std::move(lane.elements.front());
+        lane.elements.pop_front();
+        --_size;
+        if (_push_block) {
+            lane.producer.notify_one();
+        }
+        return true;
+    }
+
+private:
+    const bool _push_block;
+    bool _active;  // guarded by _mutex
+    const size_t _capacity_limit;
+    size_t _size;  // guarded by _mutex
+    Hash _hash;
+    mutex_type _mutex;
+    std::vector<Lane> _lanes;                // guarded by _mutex
+    std::deque<size_t> _ready;               // guarded by _mutex, lanes with work that nobody holds, in FIFO order
+    CacheAligned<condition_type> _consumer;  // guarded by _mutex
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_PARTITIONED_QUEUE_HPP
@@ -0,0 +1,234 @@
+/**
+ * @file priority_heap.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Heap containers backing BlockingPriorityQueue: a d-ary heap and a bucketed heap for small integer priorities.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_PRIORITY_HEAP_HPP
+#define CYBERTRON_BASE_PRIORITY_HEAP_HPP
+
+#include <array>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace cybertron::base {
+template <typename T, typename Compare = std::less<T>, size_t Arity = 4>
+/**
+ * @brief An implicit d-ary max-heap on a std::vector, ordered like std::priority_queue: the element for which
+ * {Compare} says nothing is greater is on top. With {Arity} 4 all children of a node usually share one cache line and
+ * the tree is half as deep as a binary heap, which pays off in sift-down, the hot path of pop.
+ *
+ * #NOTE Elements with equal priority come out in no particular order.
+ */
+class DaryHeap {
+public:
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+
+    explicit DaryHeap(const Compare& compare = Compare()) : _compare(compare), _elements() {}
+
+    template <typename U>
+    void push(U&& element) {
+        _elements.push_back(std::forward<U>(element));
+        _sift_up(_elements.size() - 1);
+    }
+
+    const T& top() const { return _elements.front(); }
+
+    /**
+     * @brief Move the top element into {element} and remove it. The heap must not be empty.
+     *
+     */
+    void take(T& element) {
+        element = std::move(_elements.front());
+        // Never move the last element onto itself; self-move leaves many types in an unspecified state.
+        if (_elements.size() > 1) {
+            _elements.front() = std::move(_elements.back());
+            _elements.pop_back();
+            _sift_down(0);
+        } else {
+            _elements.pop_back();
+        }
+    }
+
+    /**
+     * @brief Whether {element} ranks above the lowest element currently held. The heap must not be empty.
+     *
+     */
+    bool outranks_lowest(const T& element) const { return _compare(_elements[_lowest()], element); }
+
+    /**
+     * @brief Remove the lowest element. Only leaves can be lowest, so this scans the last 1/Arity of the heap.
+     *
+     */
+    void drop_lowest() {
+        size_t index = _lowest();
+        if (index + 1 < _elements.size()) {
+            _elements[index] = std::move(_elements.back());
+        }
+        _elements.pop_back();
+        if (index < _elements.size()) {
+            _sift_up(index);  // The slot is still a leaf, so the moved element can only need to go up.
+        }
+    }
+
+    size_t size() const { return _elements.size(); }
+
+    bool empty() const { return _elements.empty(); }
+
+    void clear() { _elements.clear(); }
+
+private:
+    static size_t _parent(size_t index) { return (index - 1) / Arity; }
+
+    void _sift_up(size_t index) {
+        T element = std::move(_elements[index]);
+        while (index) {
+            size_t parent = _parent(index);
+            if (!_compare(_elements[parent], element)) {
+                break;
+            }
+            _elements[index] = std::move(_elements[parent]);
+            index = parent;
+        }
+        _elements[index] = std::move(element);
+    }
+
+    void _sift_down(size_t index) {
+        size_t size = _elements.size();
+        T element = std::move(_elements[index]);
+        for (;;) {
+            size_t first = index * Arity + 1;
+            if (first >= size) {
+                break;
+            }
+            size_t last = first + Arity < size ? first + Arity : size;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (_compare(_elements[best], _elements[child])) {
+                    best = child;
+                }
+            }
+            if (!_compare(element, _elements[best])) {
+                break;
+            }
+            _elements[index] = std::move(_elements[best]);
+            index = best;
+        }
+        _elements[index] = std::move(element);
+    }
+
+    size_t _lowest() const {
+        size_t size = _elements.size();
+        size_t lowest = size > 1 ? _parent(size - 1) + 1 : 0;
+        for (size_t index = lowest + 1; index < size; ++index) {
+            if (_compare(_elements[index], _elements[lowest])) {
+                lowest = index;
+            }
+        }
+        return lowest;
+    }
+
+private:
+    Compare _compare;
+    std::vector<T> _elements;
+};
+
+template <typename T, size_t Levels, typename PriorityOf>
+/**
+ * @brief A heap for small integer priorities: one FIFO bucket per level plus a bitmap of the non-empty ones, so push
+ * and pop are O(1) and elements of equal priority keep their order. {PriorityOf} maps an element to an integral level
+ * in [0, Levels), higher levels pop first; levels above the range are clamped to the highest one and negative levels
+ * to 0.
+ *
+ */
+class BucketHeap {
+public:
+    static_assert(Levels >= 1 && Levels <= 64, "the bucket bitmap holds at most 64 levels");
+
+    explicit BucketHeap(const PriorityOf& priority_of = PriorityOf())
+        : _priority_of(priority_of), _buckets(), _non_empty(0), _size(0) {}
+
+    template <typename U>
+    void push(U&& element) {
+        size_t level = _level(element);
+        _buckets[level].push_back(std::forward<U>(element));
+        _non_empty |= (uint64_t(1) << level);
+        ++_size;
+    }
+
+    const T& top() const { return _buckets[_highest()].front(); }
+
+    void take(T& element) {
+        size_t level = _highest();
+        element = std::move(_buckets[level].front());
+        _buckets[level].pop_front();
+        _erased(level);
+    }
+
+    bool outranks_lowest(const T& element) const { return _level(element) > _lowest(); }
+
+    /**
+     * @brief Remove the newest element of the lowest non-empty level.
+     *
+     */
+    void drop_lowest() {
+        size_t level = _lowest();
+        _buckets[level].pop_back();
+        _erased(level);
+    }
+
+    size_t size() const { return _size; }
+
+    bool empty() const { return !_size; }
+
+    void clear() {
+        for (auto& bucket : _buckets) {
+            bucket.clear();
+        }
+        _non_empty = 0;
+        _size = 0;
+    }
+
+private:
+    size_t _level(const T& element) const {
+        auto priority = _priority_of(element);
+        if constexpr (std::is_signed_v<decltype(priority)>) {
+            if (priority < 0) {
+                return 0;  // a plain cast would wrap it around to the highest level
+            }
+        }
+        size_t level = static_cast<size_t>(priority);
+        return level < Levels ? level : Levels - 1;
+    }
+
+    size_t _highest() const { return 63 - static_cast<size_t>(__builtin_clzll(_non_empty)); }
+
+    size_t _lowest() const { return static_cast<size_t>(__builtin_ctzll(_non_empty)); }
+
+    void _erased(size_t level) {
+        if (_buckets[level].empty()) {
+            _non_empty &= ~(uint64_t(1) << level);
+        }
+        --_size;
+    }
+
+private:
+    PriorityOf _priority_of;
+    std::array<std::deque<T>, Levels> _buckets;
+    uint64_t _non_empty;
+    size_t _size;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_PRIORITY_HEAP_HPP
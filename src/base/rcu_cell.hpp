@@ -0,0 +1,130 @@
+/**
+ * @file rcu_cell.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief An RCU-style holder of read-mostly shared state, built on epoch-based reclamation.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_RCU_CELL_HPP
+#define CYBERTRON_BASE_RCU_CELL_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "epoch.hpp"
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+template <typename T>
+/**
+ * @brief A cell holding an immutable version of {T} for state that is read on every request and changes rarely, like
+ * configuration or routing tables. Readers take a Snapshot, which costs an EpochGuard and an atomic load and never
+ * blocks; writers build a new version and publish it with one atomic exchange. Each update also tries to advance the
+ * epoch and reclaim: a replaced version no Snapshot can still point to is deleted right away, one that is still held
+ * by a later update from the same thread.
+ *
+ *      RcuCell<Routes> routes(load_routes());
+ *      auto snapshot = routes.read();       // reader: wait-free, consistent for its lifetime
+ *      routes.update([](Routes& next) { next.add(route); });  // writer: copy, modify, publish
+ *
+ * Writers are serialized by a mutex of their own, which readers never touch.
+ */
+class RcuCell : public Noncopyable {
+public:
+    /**
+     * @brief A read-only view of the version current when it was taken. Keep it on the thread that took it and only
+     * for as long as needed: it holds the calling thread inside a critical section of the epoch domain.
+     *
+     */
+    class Snapshot : public Noncopyable {
+    public:
+        explicit Snapshot(const RcuCell& cell)
+            : _guard(cell._domain), _value(cell._current.load(std::memory_order_acquire)) {}
+
+        const T& operator*() const { return *_value; }
+
+        const T* operator->() const { return _value; }
+
+        const T* get() const { return _value; }
+
+    private:
+        EpochGuard _guard;
+        const T* _value;
+    };
+
+    /**
+     * @brief Construct a new Rcu Cell object.
+     *
+     * @param value The initial version.
+     * @param domain The epoch domain that tells when replaced versions can be deleted.
+     */
+    explicit RcuCell(T value, EpochDomain& domain = EpochDomain::get_instance())
+        : _domain(domain), _current(new T(std::move(value))), _writer() {}
+
+    ~RcuCell() { delete _current.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Take a snapshot of the current version.
+     *
+     */
+    Snapshot read() const { return Snapshot(*this); }
+
+    /**
+     * @brief Call reader(value) on the current version and return a copy of what it returns. A reference into the
+     * version would outlive the snapshot that keeps it from being reclaimed, so it is never passed through.
+     *
+     */
+    template <typename Reader>
+    auto read_with(Reader&& reader) const {
+        Snapshot snapshot(*this);
+        return reader(*snapshot);
+    }
+
+    /**
+     * @brief Publish {value} as the new version.
+     *
+     */
+    void store(T value) {
+        T* next = new T(std::move(value));
+        std::lock_guard<std::mutex> lock(_writer);
+        _publish(next);
+    }
+
+    /**
+     * @brief Copy the current version, let {modify} change the copy as modify(T&) and publish it. Concurrent updates
+     * are applied one after another, so none is lost.
+     *
+     */
+    template <typename Modify>
+    void update(Modify&& modify) {
+        std::lock_guard<std::mutex> lock(_writer);
+        std::unique_ptr<T> next(new T(*_current.load(std::memory_order_relaxed)));
+        modify(*next);
+        _publish(next.release());
+    }
+
+private:
+    // Must hold _writer. Updates are rare, so push the epoch on now rather than wait for the domain's retire threshold,
+    // which would keep up to that many stale versions alive; two advances are what a version retired now needs.
+    void _publish(T* next) {
+        _domain.retire(_current.exchange(next, std::memory_order_acq_rel));
+        _domain.try_advance();
+        _domain.collect();
+    }
+
+private:
+    EpochDomain& _domain;
+    std::atomic<T*> _current;
+    std::mutex _writer;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_RCU_CELL_HPP
@@ -0,0 +1,179 @@
+/**
+ * @file reclamation.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Plumbing shared by the memory reclamation domains: retired objects and per-thread records.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_RECLAMATION_HPP
+#define CYBERTRON_BASE_RECLAMATION_HPP
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <unordered_set>
+
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+namespace detail {
+// An object unlinked from a lock-free structure, to be deleted once no reader can still hold it.
+struct Retired {
+    void* pointer;
+    void (*deleter)(void*);
+
+    void reclaim() const { deleter(pointer); }
+};
+
+template <typename T>
+void delete_retired(void* pointer) {
+    delete static_cast<T*>(pointer);
+}
+
+// The base of the records a registry hands out. A record is never freed before its registry, only given back.
+struct RegistryRecord {
+    std::atomic<bool> in_use{false};
+    RegistryRecord* next_record = nullptr;
+};
+
+// The ids of the registries alive, so that exiting threads do not touch records of destroyed ones. Never destroyed,
+// since threads may exit after static destruction has begun.
+struct LiveRegistries {
+    std::mutex mutex;
+    std::unordered_set<uint64_t> ids;  // guarded by mutex
+    uint64_t next_id = 0;              // guarded by mutex
+
+    static LiveRegistries& get() {
+        static LiveRegistries* registries = new LiveRegistries;
+        return *registries;
+    }
+};
+
+// The records the calling thread holds, one per registry, given back when the thread exits.
+class ThreadRecords : public Noncopyable {
+public:
+    static ThreadRecords& current() {
+        thread_local ThreadRecords records;
+        return records;
+    }
+
+    ~ThreadRecords() {
+        LiveRegistries& live = LiveRegistries::get();
+        std::lock_guard<std::mutex> lock(live.mutex);
+        for (const Entry& entry : _entries) {
+            if (live.ids.count(entry.id)) {
+                entry.record->in_use.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    RegistryRecord* find(uint64_t id) const {
+        for (const Entry& entry : _entries) {
+            if (entry.id == id) {
+                return entry.record;
+            }
+        }
+        return nullptr;
+    }
+
+    void add(uint64_t id, RegistryRecord* record) {
+        LiveRegistries& live = LiveRegistries::get();
+        std::lock_guard<std::mutex> lock(live.mutex);
+        size_t kept = 0;
+        for (const Entry& entry : _entries) {
+            if (live.ids.count(entry.id)) {
+                _entries[kept++] = entry;
+            }
+        }
+        _entries.resize(kept);
+        _entries.push_back({id, record});
+    }
+
+private:
+    struct Entry {
+        uint64_t id;
+        RegistryRecord* record;
+    };
+
+    ThreadRecords() = default;
+
+private:
+    std::vector<Entry> _entries;
+};
+
+// A grow-only list of records that are claimed and given back, without locks. {Record} derives from RegistryRecord.
+template <typename Record>
+class RecordRegistry : public Noncopyable {
+public:
+    RecordRegistry() : _head(nullptr), _id(0) {
+        LiveRegistries& live = LiveRegistries::get();
+        std::lock_guard<std::mutex> lock(live.mutex);
+        _id = live.next_id++;
+        live.ids.insert(_id);
+    }
+
+    ~RecordRegistry() {
+        {
+            LiveRegistries& live = LiveRegistries::get();
+            std::lock_guard<std::mutex> lock(live.mutex);
+            live.ids.erase(_id);
+        }
+        RegistryRecord* record = _head.load(std::memory_order_acquire);
+        while (record) {
+            RegistryRecord* next = record->next_record;
+            delete static_cast<Record*>(record);
+            record = next;
+        }
+    }
+
+    // A free record, reused if there is one and allocated otherwise. Give it back through in_use.
+    Record* claim() {
+        for (RegistryRecord* record = _head.load(std::memory_order_acquire); record; record = record->next_record) {
+            bool expected = false;
+            if ((!record->in_use.load(std::memory_order_relaxed)) &&
+                record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return static_cast<Record*>(record);
+            }
+        }
+        Record* record = new Record;
+        record->in_use.store(true, std::memory_order_relaxed);
+        RegistryRecord* head = _head.load(std::memory_order_relaxed);
+        do {
+            record->next_record = head;
+        } while (!_head.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+        return record;
+    }
+
+    // The record of the calling thread, claimed on first use and given back when the thread exits.
+    Record* local() {
+        ThreadRecords& records = ThreadRecords::current();
+        if (RegistryRecord* record = records.find(_id)) {
+            return static_cast<Record*>(record);
+        }
+        Record* record = claim();
+        records.add(_id, record);
+        return record;
+    }
+
+    // Visits every record, in use or not.
+    template <typename Visitor>
+    void for_each(Visitor&& visit) {
+        for (RegistryRecord* record = _head.load(std::memory_order_acquire); record; record = record->next_record) {
+            visit(*static_cast<Record*>(record));
+        }
+    }
+
+private:
+    std::atomic<RegistryRecord*> _head;
+    uint64_t _id;
+};
+}  // namespace detail
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_RECLAMATION_HPP
@@ -0,0 +1,309 @@
+/**
+ * @file record_ring.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A single-producer single-consumer ring of variable-size records, written and read in place.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_RECORD_RING_HPP
+#define CYBERTRON_BASE_RECORD_RING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+
+#include "noncopyable.hpp"
+#include "event_count.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief A byte ring for variable-size messages in the style of a bip buffer. The producer reserve()s a contiguous
+ * region, builds the record in place and commit()s it; the consumer read()s records in place, in order, and
+ * release()s each when done. Nothing is allocated per record and the stream stays contiguous in memory, which the
+ * cache and the hardware prefetcher like far better than a queue of pointers to scattered heap blocks.
+ *
+ * Every record starts with an 8 byte header holding its size as a full 64-bit value and is padded to 8 bytes, so
+ * payloads are 8 byte aligned. A record never wraps around the end of the ring: when it does not fit there, a wrap
+ * marker fills the rest of the ring and the record starts over at offset 0. If the ring is empty at that point, the
+ * producer moves both positions to offset 0 instead, so the skipped tail is not held against the record and anything
+ * up to max_record_size() fits into an empty ring.
+ *
+ * Exactly one thread may produce and one may consume; the read and write positions are each written by one side
+ * only, but for that rewind, and sit on cache lines of their own. Waiting spins briefly and then sleeps on an
+ * EventCount. Committing and releasing only touch an EventCount while the other side waits on it, so a ring whose
+ * consumer keeps up costs no shared write per record beyond the positions.
+ */
+class RecordRing : public Noncopyable {
+public:
+    /**
+     * @brief A record as seen by the consumer, valid until release().
+     *
+     */
+    struct Record {
+        const char* data = nullptr;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief Construct a new Record Ring object.
+     *
+     * @param capacity The size of the ring in bytes, rounded up to a power of two and at least 64.
+     */
+    explicit RecordRing(size_t capacity)
+        : _capacity(_round_up(capacity)),
+          _buffer(new char[_capacity]),
+          _active(true),
+          _reserved_at(0),
+          _reserved_wraps(false),
+          _cached_read(0),
+          _next_read(0),
+          _cached_write(0),
+          _write(),
+          _read(),
+          _waiting_reader(),
+          _waiting_writer(),
+          _readable(),
+          _writable() {
+        _write->store(0, std::memory_order_relaxed);
+        _read->store(0, std::memory_order_relaxed);
+        _waiting_reader->store(false, std::memory_order_relaxed);
+        _waiting_writer->store(false, std::memory_order_relaxed);
+    }
+
+    ~RecordRing() { close(); }
+
+    /**
+     * @brief Wake up both sides for good. Records committed before are still readable.
+     *
+     */
+    void close() {
+        _active.store(false, std::memory_order_release);
+        _readable.notify_all();
+        _writable.notify_all();
+    }
+
+    /**
+     * @brief The largest record that fits at all, which needs the whole ring to itself.
+     *
+     */
+    size_t max_record_size() const { return _capacity - kHeader; }
+
+    size_t capacity() const { return _capacity; }
+
+    /**
+     * @brief Producer side: reserve {size} contiguous bytes for the next record if the ring has room right now.
+     *
+     * @return where to write the record, or nullptr if it does not fit now (or ever, beyond max_record_size()).
+     */
+    char* try_reserve(size_t size) {
+        if (size > max_record_size()) {
+            return nullptr;
+        }
+        uint64_t write = _write->load(std::memory_order_relaxed);
+        size_t offset = write & (_capacity - 1);
+        size_t need = _footprint(size);
+        if (offset && need > _capacity - offset) {
+            _cached_read = _read->load(std::memory_order_acquire);
+            if (_cached_read == write) {
+                // The consumer has released everything, so nothing is read while both positions are rewound. The
+                // read position goes first: a consumer that sees the new write position then sees it too.
+                write += _capacity - offset;
+                _read->store(write, std::memory_order_release);
+                _write->store(write, std::memory_order_release);
+                _cached_read = write;
+                offset = 0;
+            }
+        }
+        _reserved_wraps = need > _capacity - offset;
+        size_t total = _reserved_wraps ? _capacity - offset + need : need;
+        if (_capacity - (write - _cached_read) < total) {
+            _cached_read = _read->load(std::memory_order_acquire);
+            if (_capacity - (write - _cached_read) < total) {
+                return nullptr;
+            }
+        }
+        _reserved_at = write;
+        return _buffer.get() + (_reserved_wraps ? 0 : offset) + kHeader;
+    }
+
+    /**
+     * @brief Producer side: like try_reserve(), but waits within {timeout} microseconds for the consumer to make room.
+     * If the {timeout} parameter is set to 0, then it will wait until there is room or the ring is closed.
+     *
+     * @return where to write the record, or nullptr on timeout, if the ring is closed or the record is too large.
+     */
+    char* reserve(size_t size, const int64_t& timeout = 0) {
+        if (char* region = try_reserve(size)) {
+            return region;
+        }
+        return _wait(_writable, *_waiting_writer, timeout, [&] { return try_reserve(size); },
+                     size <= max_record_size());
+    }
+
+    /**
+     * @brief Producer side: publish the record reserved last, which is {size} bytes long, at most as many as were
+     * reserved.
+     *
+     */
+    void commit(size_t size) {
+        size_t offset = _reserved_at & (_capacity - 1);
+        uint64_t write = _reserved_at;
+        if (_reserved_wraps) {
+            _store_header(offset, kWrapMarker);
+            write += _capacity - offset;
+            offset = 0;
+        }
+        _store_header(offset, size);
+        _write->store(write + _footprint(size), std::memory_order_release);
+        // Pairs with the fence in _wait(): either the consumer sees the record, or this sees it waiting and notifies.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiting_reader->load(std::memory_order_relaxed)) {
+            _readable.notify_all();
+        }
+    }
+
+    /**
+     * @brief Consumer side: look at the next record if there is one. It stays in the ring until release().
+     *
+     */
+    bool try_read(Record& record) {
+        uint64_t read = _read->load(std::memory_order_acquire);
+        if (read >= _cached_write) {
+            _cached_write = _write->load(std::memory_order_acquire);
+            // Reload after the write position, in case the producer rewound an empty ring in between.
+            read = _read->load(std::memory_order_acquire);
+            if (read >= _cached_write) {
+                return false;
+            }
+        }
+        size_t offset = read & (_capacity - 1);
+        uint64_t size = _load_header(offset);
+        if (size == kWrapMarker) {
+            read += _capacity - offset;
+            offset = 0;
+            size = _load_header(0);
+        }
+        record.data = _buffer.get() + offset + kHeader;
+        record.size = size;
+        _next_read = read + _footprint(size);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: like try_read(), but waits within {timeout} microseconds for a record. If the {timeout}
+     * parameter is set to 0, then it will wait until one is committed or the ring is closed and drained.
+     *
+     */
+    bool read(Record& record, const int64_t& timeout = 0) {
+        return try_read(record) || _wait(_readable, *_waiting_reader, timeout, [&] { return try_read(record); }, true);
+    }
+
+    /**
+     * @brief Consumer side: hand the record read last back to the producer.
+     *
+     */
+    void release() {
+        _read->store(_next_read, std::memory_order_release);
+        // Pairs with the fence in _wait(), like commit().
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiting_writer->load(std::memory_order_relaxed)) {
+            _writable.notify_all();
+        }
+    }
+
+    /**
+     * @brief The number of bytes in use, headers and padding included. Only a snapshot.
+     *
+     */
+    size_t used() const {
+        uint64_t write = _write->load(std::memory_order_acquire);
+        uint64_t read = _read->load(std::memory_order_acquire);
+        return read < write ? static_cast<size_t>(write - read) : 0;
+    }
+
+    bool empty() const { return !used(); }
+
+private:
+    static constexpr size_t kHeader = 8;
+    static constexpr uint64_t kWrapMarker = UINT64_MAX;
+
+    static size_t _round_up(size_t capacity) {
+        size_t size = 64;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    static size_t _footprint(size_t size) { return (kHeader + size + 7) & ~size_t(7); }
+
+    void _store_header(size_t offset, uint64_t size) { std::memcpy(_buffer.get() + offset, &size, sizeof(size)); }
+
+    uint64_t _load_header(size_t offset) const {
+        uint64_t size = 0;
+        std::memcpy(&size, _buffer.get() + offset, sizeof(size));
+        return size;
+    }
+
+    // Retries {attempt} until it succeeds, sleeping on {event} in between. {waiting} is raised for the whole wait, so
+    // the other side knows to notify {event}.
+    template <typename Attempt>
+    auto _wait(EventCount& event, std::atomic<bool>& waiting, const int64_t& timeout, Attempt attempt, bool possible)
+        -> decltype(attempt()) {
+        waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto result = _wait_raised(event, timeout, attempt, possible);
+        waiting.store(false, std::memory_order_relaxed);
+        return result;
+    }
+
+    template <typename Attempt>
+    auto _wait_raised(EventCount& event, const int64_t& timeout, Attempt attempt, bool possible)
+        -> decltype(attempt()) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+        for (;;) {
+            EventCount::Key key = event.prepare_wait();
+            if (auto result = attempt()) {
+                return result;
+            }
+            if ((!possible) || (!_active.load(std::memory_order_acquire))) {
+                return {};
+            }
+            if (!timeout) {
+                event.wait(key);
+            } else if (!event.wait_until(key, deadline)) {
+                return attempt();
+            }
+        }
+    }
+
+private:
+    const size_t _capacity;
+    std::unique_ptr<char[]> _buffer;
+    std::atomic<bool> _active;
+    // Producer only.
+    uint64_t _reserved_at;
+    bool _reserved_wraps;
+    uint64_t _cached_read;
+    // Consumer only.
+    uint64_t _next_read;
+    uint64_t _cached_write;
+    CacheAligned<std::atomic<uint64_t>> _write;  // the end of the committed records, written by the producer
+    CacheAligned<std::atomic<uint64_t>> _read;   // the start of the unreleased records, written by the consumer
+    CacheAligned<std::atomic<bool>> _waiting_reader;  // the consumer is about to sleep on _readable
+    CacheAligned<std::atomic<bool>> _waiting_writer;  // the producer is about to sleep on _writable
+    EventCount _readable;
+    EventCount _writable;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_RECORD_RING_HPP
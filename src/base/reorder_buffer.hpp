@@ -0,0 +1,210 @@
+/**
+ * @file reorder_buffer.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A bounded reorder buffer that puts out-of-order results back into sequence order.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_REORDER_BUFFER_HPP
+#define CYBERTRON_BASE_REORDER_BUFFER_HPP
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+
+#include "noncopyable.hpp"
+#include "lock_policy.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+template <typename T, typename LockPolicy = StdLockPolicy>
+/**
+ * @brief A reorder buffer for stages parallelized over a worker pool that must still preserve input order. The stage
+ * feeding the workers stamps every item with next_ticket(), workers put() their results under that sequence number in
+ * whatever order they finish, and pop() hands the results downstream strictly in sequence.
+ *
+ * Only sequence numbers within {window} of the next one to be popped are accepted; a worker that gets ahead of that
+ * blocks in put() until the stragglers have caught up. A slow item therefore holds back at most {window} results
+ * instead of buffering without bound, and the window doubles as backpressure on the workers.
+ */
+class ReorderBuffer : public Noncopyable {
+public:
+    using mutex_type = typename LockPolicy::mutex_type;
+    using condition_type = typename LockPolicy::condition_type;
+
+    /**
+     * @brief Construct a new Reorder Buffer object.
+     *
+     * @param window The maximum number of results held, counted from the next sequence number to be popped.
+     */
+    explicit ReorderBuffer(size_t window)
+        : _tickets(0),
+          _active(true),
+          _head(0),
+          _size(0),
+          _blocked_producers(0),
+          _mutex(),
+          _slots(window ? window : 1),
+          _consumer(),
+          _producer() {}
+
+    ~ReorderBuffer() { close(); }
+
+    /**
+     * @brief Close the buffer, drop all results and wake up every waiter.
+     *
+     */
+    void close() {
+        {
+            std::lock_guard<mutex_type> lock(_mutex);
+            _active = false;
+            for (auto& slot : _slots) {
+                slot.reset();
+            }
+            _size = 0;
+        }
+        _producer->notify_all();
+        _consumer->notify_all();
+    }
+
+    bool closed() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return !_active;
+    }
+
+    /**
+     * @brief Hand out the next sequence number, starting at 0. Call it from the stage that feeds the workers, in
+     * input order, not from the workers.
+     *
+     */
+    uint64_t next_ticket() { return _tickets.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Put the result for {sequence} within {timeout} microseconds, blocking while {sequence} is beyond the
+     * window. If the {timeout} parameter is set to 0, then it will wait until the window reaches it or the buffer is
+     * closed.
+     *
+     * @return true if the result was stored, false on timeout, if the buffer is closed, or if {sequence} was already
+     * popped or put.
+     */
+    bool put(uint64_t sequence, T value, const int64_t& timeout = 0) {
+        bool wake = false;
+        {
+            std::unique_lock<mutex_type> lock(_mutex);
+            if (!_in_window(sequence)) {
+                ++_blocked_producers;
+                bool in_time = detail::timed_wait(lock, *_producer, timeout,
+                                                  [&] { return (!_active) || _in_window(sequence); });
+                --_blocked_producers;
+                if (!in_time) {
+                    return false;
+                }
+            }
+            if ((!_active) || sequence < _head) {
+                return false;
+            }
+            std::optional<T>& slot = _slot(sequence);
+            if (slot) {
+                return false;
+            }
+            slot.emplace(std::move(value));
+            ++_size;
+            wake = (sequence == _head);
+        }
+        if (wake) {
+            _consumer->notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Pop the result with the next sequence number within {timeout} microseconds in a blocking way. If the
+     * {timeout} parameter is set to 0, then it will wait until that result arrives or the buffer is closed.
+     *
+     * @return true if one result was popped, false on timeout or if the buffer is closed.
+     */
+    bool pop(T& value, const int64_t& timeout = 0) { return _pop(value, true, timeout); }
+
+    /**
+     * @brief Pop the result with the next sequence number only if it has already arrived.
+     *
+     */
+    bool try_pop(T& value) { return _pop(value, false, 0); }
+
+    /**
+     * @brief The sequence number pop() delivers next.
+     *
+     */
+    uint64_t next_sequence() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _head;
+    }
+
+    /**
+     * @brief The number of results held, including out-of-order ones that cannot be popped yet.
+     *
+     */
+    size_t size() {
+        std::lock_guard<mutex_type> lock(_mutex);
+        return _size;
+    }
+
+    size_t window() const { return _slots.size(); }
+
+private:
+    bool _in_window(uint64_t sequence) const { return sequence < _head + _slots.size(); }
+
+    std::optional<T>& _slot(uint64_t sequence) { return _slots[sequence % _slots.size()]; }
+
+    bool _pop(T& value, bool block, const int64_t& timeout) {
+        bool more = false;
+        {
+            std::unique_lock<mutex_type> lock(_mutex);
+            auto arrived = [&] { return (!_active) || _slot(_head).has_value(); };
+            if (block ? (!detail::timed_wait(lock, *_consumer, timeout, arrived)) : (!arrived())) {
+                return false;
+            }
+            if (!_active) {
+                return false;
+            }
+            std::optional<T>& slot = _slot(_head);
+            value = std::move(*slot);
+            slot.reset();
+            --_size;
+            ++_head;
+            more = _slot(_head).has_value();
+            // Every blocked producer waits for its own sequence number, and the one that just entered the window is
+            // not known, so wake them all. Nobody blocks while workers keep within the window.
+            if (_blocked_producers) {
+                _producer->notify_all();
+            }
+        }
+        if (more) {
+            _consumer->notify_one();
+        }
+        return true;
+    }
+
+private:
+    std::atomic<uint64_t> _tickets;
+    bool _active;               // guarded by _mutex
+    uint64_t _head;             // guarded by _mutex, the next sequence number to pop
+    size_t _size;               // guarded by _mutex
+    size_t _blocked_producers;  // guarded by _mutex
+    mutex_type _mutex;
+    std::vector<std::optional<T>> _slots;    // guarded by _mutex, ring indexed by sequence number
+    CacheAligned<condition_type> _consumer;  // guarded by _mutex
+    CacheAligned<condition_type> _producer;  // guarded by _mutex
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_REORDER_BUFFER_HPP
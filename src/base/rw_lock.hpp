@@ -0,0 +1,209 @@
+/**
+ * @file rw_lock.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Reader-writer spin locks: a compact one and a reader-biased distributed one.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_RW_LOCK_HPP
+#define CYBERTRON_BASE_RW_LOCK_HPP
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstdint>
+
+#include "cpu_relax.hpp"
+#include "noncopyable.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+namespace detail {
+// Backs off while spinning on a lock: cpu_relax() at first, then yields the CPU to whoever holds the lock.
+class SpinBackoff {
+public:
+    void pause() {
+        if (_spins < kSpinCount) {
+            ++_spins;
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr int kSpinCount = 64;
+    int _spins = 0;
+};
+}  // namespace detail
+
+/**
+ * @brief A reader-writer spin lock in a single 32-bit word, for short critical sections. Writers are preferred: a
+ * waiting writer stops new readers from entering, so a steady stream of readers cannot starve it.
+ *
+ * Satisfies the standard Lockable and SharedLockable requirements, so std::lock_guard, std::unique_lock and
+ * std::shared_lock work as usual.
+ */
+class RwSpinLock : public Noncopyable {
+public:
+    RwSpinLock() : _state(0) {}
+
+    void lock() {
+        detail::SpinBackoff backoff;
+        for (;;) {
+            uint32_t state = _state.load(std::memory_order_relaxed);
+            if (!(state & ~kPending)) {
+                if (_state.compare_exchange_weak(state, kWriter, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    return;
+                }
+            } else if (!(state & kPending)) {
+                _state.fetch_or(kPending, std::memory_order_relaxed);
+            }
+            backoff.pause();
+        }
+    }
+
+    bool try_lock() {
+        uint32_t state = _state.load(std::memory_order_relaxed);
+        return (!(state & ~kPending)) &&
+               _state.compare_exchange_strong(state, kWriter, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() { _state.fetch_and(~kWriter, std::memory_order_release); }
+
+    void lock_shared() {
+        detail::SpinBackoff backoff;
+        while (!try_lock_shared()) {
+            backoff.pause();
+        }
+    }
+
+    bool try_lock_shared() {
+        if (_state.load(std::memory_order_relaxed) & (kWriter | kPending)) {
+            return false;
+        }
+        if (_state.fetch_add(kReader, std::memory_order_acquire) & (kWriter | kPending)) {
+            _state.fetch_sub(kReader, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    void unlock_shared() { _state.fetch_sub(kReader, std::memory_order_release); }
+
+private:
+    static constexpr uint32_t kWriter = 1;
+    static constexpr uint32_t kPending = 2;  // a writer is waiting
+    static constexpr uint32_t kReader = 4;   // readers are counted from bit 2 on
+
+    std::atomic<uint32_t> _state;
+};
+
+/**
+ * @brief A reader-biased reader-writer lock for data that is read all the time and rarely written. Every reader
+ * counts itself in a slot of its own thread, on a cache line of its own, and otherwise only reads the writer flag, so
+ * readers on different cores never contend. A writer pays for that: it raises the flag and then waits until every
+ * slot has drained.
+ *
+ * Threads are spread over {slots} slots in the order they first take the lock, which keeps lock_shared() and
+ * unlock_shared() on the same counter even when the thread migrates between CPUs. Satisfies the standard Lockable
+ * and SharedLockable requirements.
+ */
+class DistributedRwLock : public Noncopyable {
+public:
+    /**
+     * @brief Construct a new Distributed Rw Lock object.
+     *
+     * @param slots The number of reader slots, rounded up to a power of two. The number of CPUs by default.
+     */
+    explicit DistributedRwLock(size_t slots = std::thread::hardware_concurrency())
+        : _mask(_round_up(slots) - 1), _slots(new CacheAligned<std::atomic<uint32_t>>[_mask + 1]), _writer() {
+        for (size_t i = 0; i <= _mask; ++i) {
+            _slots[i]->store(0, std::memory_order_relaxed);
+        }
+        _writer->store(false, std::memory_order_relaxed);
+    }
+
+    void lock() {
+        detail::SpinBackoff backoff;
+        bool expected = false;
+        while (!_writer->compare_exchange_weak(expected, true, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            expected = false;
+            backoff.pause();
+        }
+        // seq_cst, not acquire: only loads inside the single total order pair with the fetch_add in try_lock_shared().
+        for (size_t i = 0; i <= _mask; ++i) {
+            while (_slots[i]->load(std::memory_order_seq_cst)) {
+                backoff.pause();
+            }
+        }
+    }
+
+    bool try_lock() {
+        bool expected = false;
+        if (!_writer->compare_exchange_strong(expected, true, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        for (size_t i = 0; i <= _mask; ++i) {
+            if (_slots[i]->load(std::memory_order_seq_cst)) {
+                _writer->store(false, std::memory_order_release);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void unlock() { _writer->store(false, std::memory_order_release); }
+
+    void lock_shared() {
+        detail::SpinBackoff backoff;
+        while (!try_lock_shared()) {
+            while (_writer->load(std::memory_order_relaxed)) {
+                backoff.pause();
+            }
+        }
+    }
+
+    bool try_lock_shared() {
+        std::atomic<uint32_t>& slot = *_slots[_thread_index() & _mask];
+        // Pairs with the flag in lock(): either the writer sees this reader, or this reader sees the writer.
+        slot.fetch_add(1, std::memory_order_seq_cst);
+        if (_writer->load(std::memory_order_seq_cst)) {
+            slot.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    void unlock_shared() { _slots[_thread_index() & _mask]->fetch_sub(1, std::memory_order_release); }
+
+private:
+    static size_t _round_up(size_t size) {
+        size_t rounded = 1;
+        while (rounded < size) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    static size_t _thread_index() {
+        static std::atomic<size_t> next{0};
+        thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+private:
+    const size_t _mask;
+    std::unique_ptr<CacheAligned<std::atomic<uint32_t>>[]> _slots;  // readers inside, per slot
+    CacheAligned<std::atomic<bool>> _writer;                        // a writer holds or is acquiring the lock
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_RW_LOCK_HPP
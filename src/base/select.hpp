@@ -0,0 +1,153 @@
+/**
+ * @file select.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief Go-style select over several BlockingQueues.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_SELECT_HPP
+#define CYBERTRON_BASE_SELECT_HPP
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include "noncopyable.hpp"
+#include "event_count.hpp"
+#include "blocking_queue.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief Blocks until one of several queue operations can proceed, performs exactly that one and reports which it was.
+ * The queues may have different element types and locking policies.
+ *
+ *      Select select;
+ *      select.on_pop(control, command).on_pop(bulk, chunk).on_push(replies, reply);
+ *      switch (select.wait(1000)) { ... }
+ *
+ * When several cases are ready at once, the first one checked wins; the starting case rotates on every call so no
+ * queue is starved. A Select object may be reused, but not shared between threads.
+ */
+class Select : public Noncopyable {
+public:
+    Select() : _cases(), _event(), _next(0) {}
+
+    /**
+     * @brief Add a case popping from the front of {queue} into {element}. {element} must outlive wait().
+     *
+     */
+    template <typename T, typename LockPolicy>
+    Select& on_pop(BlockingQueue<T, LockPolicy>& queue, T& element) {
+        _cases.push_back({[&queue, &element] { return queue.try_pop_front(element); },
+                          [&queue] { return queue.closed(); },
+                          [&queue](EventCount* event) { queue._attach_selector(event); },
+                          [&queue](EventCount* event) { queue._detach_selector(event); }});
+        return *this;
+    }
+
+    /**
+     * @brief Add a case pushing a copy of {element} to the back of {queue}. {element} must outlive wait().
+     *
+     */
+    template <typename T, typename LockPolicy>
+    Select& on_push(BlockingQueue<T, LockPolicy>& queue, const T& element) {
+        _cases.push_back({[&queue, &element] { return queue.try_push_back(element); },
+                          [&queue] { return queue.closed(); },
+                          [&queue](EventCount* event) { queue._attach_selector(event); },
+                          [&queue](EventCount* event) { queue._detach_selector(event); }});
+        return *this;
+    }
+
+    /**
+     * @brief Wait within {timeout} microseconds until one case can proceed and perform it. If the {timeout} parameter
+     * is set to 0, then it will wait until success or all queues are closed.
+     *
+     * @param timeout Timeout in microseconds.
+     * @return the index of the performed case in the order the cases were added,
+     * @return -1 on timeout, if there are no cases, or if every queue is closed.
+     */
+    int wait(const int64_t& timeout = 0) {
+        if (_cases.empty()) {
+            return -1;
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+        for (auto& one : _cases) {
+            one.attach(&_event);
+        }
+        int chosen = -1;
+        bool expired = false;
+        for (;;) {
+            // Taking the key before trying makes any state change after a failed attempt wake us up.
+            EventCount::Key key = _event.prepare_wait();
+            bool all_closed = true;
+            chosen = _attempt(all_closed);
+            if (chosen >= 0 || all_closed || expired) {
+                _event.cancel_wait();
+                break;
+            }
+            if (timeout) {
+                expired = !_event.wait_until(key, deadline);
+            } else {
+                _event.wait(key);
+            }
+        }
+        for (auto& one : _cases) {
+            one.detach(&_event);
+        }
+        return chosen;
+    }
+
+    /**
+     * @brief Perform one case that can proceed right now, without blocking.
+     *
+     * @return the index of the performed case, or -1 if none could proceed.
+     */
+    int poll() {
+        bool all_closed = true;
+        return _attempt(all_closed);
+    }
+
+    void clear() { _cases.clear(); }
+
+private:
+    struct Case {
+        std::function<bool()> attempt;
+        std::function<bool()> closed;
+        std::function<void(EventCount*)> attach;
+        std::function<void(EventCount*)> detach;
+    };
+
+    int _attempt(bool& all_closed) {
+        size_t count = _cases.size();
+        if (!count) {
+            return -1;
+        }
+        size_t start = _next;
+        _next = (_next + 1) % count;
+        for (size_t i = 0; i < count; ++i) {
+            size_t index = (start + i) % count;
+            if (_cases[index].attempt()) {
+                return static_cast<int>(index);
+            }
+            if (!_cases[index].closed()) {
+                all_closed = false;
+            }
+        }
+        return -1;
+    }
+
+private:
+    std::vector<Case> _cases;
+    EventCount _event;
+    size_t _next;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_SELECT_HPP
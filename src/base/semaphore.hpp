@@ -0,0 +1,110 @@
+/**
+ * @file semaphore.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A counting semaphore built directly on futex(2). #NOTE This only works on Linux.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_SEMAPHORE_HPP
+#define CYBERTRON_BASE_SEMAPHORE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "futex.hpp"
+#include "cpu_relax.hpp"
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief A counting semaphore. acquire() is a single CAS while permits are available, and release() only enters the
+ * kernel when a thread is actually asleep in acquire().
+ *
+ */
+class Semaphore : public Noncopyable {
+public:
+    explicit Semaphore(uint32_t initial = 0) : _count(initial), _waiters(0) {}
+
+    bool try_acquire() {
+        uint32_t count = _count.load(std::memory_order_relaxed);
+        while (count) {
+            if (_count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void acquire() {
+        while (!_spin_acquire()) {
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (!_count.load(std::memory_order_seq_cst)) {
+                detail::futex_wait(&_count, 0);
+            }
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Acquire one permit, giving up at {deadline}.
+     *
+     * @return true if a permit was acquired, false on timeout.
+     */
+    template <typename Clock, typename Duration>
+    bool try_acquire_until(const std::chrono::time_point<Clock, Duration>& deadline) {
+        auto steady_deadline = detail::to_steady_deadline(deadline);
+        while (!_spin_acquire()) {
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+            bool in_time = true;
+            if (!_count.load(std::memory_order_seq_cst)) {
+                in_time = detail::futex_wait_until(&_count, 0, steady_deadline);
+            }
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+            if (!in_time) {
+                return try_acquire();
+            }
+        }
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool try_acquire_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return try_acquire_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    void release(uint32_t count = 1) {
+        _count.fetch_add(count, std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_seq_cst)) {
+            detail::futex_wake(&_count, static_cast<int>(count));
+        }
+    }
+
+    uint32_t available() const { return _count.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int kSpinCount = 128;
+
+    bool _spin_acquire() {
+        for (int i = 0; i < kSpinCount; ++i) {
+            if (try_acquire()) {
+                return true;
+            }
+            cpu_relax();
+        }
+        return false;
+    }
+
+private:
+    std::atomic<uint32_t> _count;
+    std::atomic<uint32_t> _waiters;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_SEMAPHORE_HPP
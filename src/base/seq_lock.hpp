@@ -0,0 +1,114 @@
+/**
+ * @file seq_lock.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A sequence lock publishing the latest value of small trivially copyable data.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_SEQ_LOCK_HPP
+#define CYBERTRON_BASE_SEQ_LOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cpu_relax.hpp"
+#include "noncopyable.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+template <typename T>
+/**
+ * @brief A sequence lock for the latest value of small, trivially copyable data such as a quote, a position or a
+ * telemetry sample. The writer never waits and readers never write shared memory, so any number of readers can poll
+ * the value without slowing the writer or each other; a reader that overlaps a store simply copies again.
+ *
+ * The value is kept in atomic words rather than as a plain {T}, so the copies a reader makes while the writer is busy
+ * are well defined and are thrown away when the sequence number shows the overlap.
+ *
+ * There must be one writer at a time; several writers have to serialize among themselves.
+ */
+class alignas(hardware_destructive_interference_size) SeqLock : public Noncopyable {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+public:
+    explicit SeqLock(const T& value = T()) : _sequence(0), _words() { _write(value); }
+
+    /**
+     * @brief Publish {value}. Never blocks.
+     *
+     */
+    void store(const T& value) {
+        uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        // Readers that see any of the new words must see the odd sequence number.
+        std::atomic_thread_fence(std::memory_order_release);
+        _write(value);
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief The latest value, retrying while a store overlaps the copy.
+     *
+     */
+    T load() const {
+        T value;
+        while (!try_load(value)) {
+            cpu_relax();
+        }
+        return value;
+    }
+
+    /**
+     * @brief Copy the latest value into {value} unless a store overlaps the copy.
+     *
+     * @return true if {value} holds a consistent value.
+     */
+    bool try_load(T& value) const {
+        uint64_t before = _sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = _words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief The number of stores so far, to tell whether the value changed since the last look.
+     *
+     */
+    uint64_t version() const { return _sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void _write(const T& value) {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < kWords; ++i) {
+            _words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<uint64_t> _sequence;  // odd while a store is in progress
+    std::atomic<uint64_t> _words[kWords];
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_SEQ_LOCK_HPP
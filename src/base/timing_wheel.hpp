@@ -0,0 +1,337 @@
+/**
+ * @file timing_wheel.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A hierarchical timing wheel with O(1) schedule and cancel.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_TIMING_WHEEL_HPP
+#define CYBERTRON_BASE_TIMING_WHEEL_HPP
+
+#include <array>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+/**
+ * @brief Handle of a scheduled timer, used to cancel it. A default-constructed id refers to no timer, and the id of a
+ * timer that already fired or was cancelled never matches a later one.
+ *
+ */
+struct TimerId {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+};
+
+template <typename T>
+/**
+ * @brief A hierarchical timing wheel in the style of the Linux kernel timers: 4 levels of 64 slots, each level 64
+ * times coarser than the one below. A timer goes into the slot of the coarsest level that still resolves it and is
+ * cascaded to finer levels as time approaches, so schedule() and cancel() are O(1) however many timers are pending.
+ * Timers further out than 64^4 ticks are parked in the top level and re-cascaded until they are in range.
+ *
+ * Nodes live in a slab addressed by index, so steady-state operation does not allocate. Not thread-safe; DelayQueue
+ * adds the locking.
+ */
+class TimingWheel : public Noncopyable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Construct a new Timing Wheel object.
+     *
+     * @param tick The resolution. Timers fire on the first tick boundary at or after their deadline, never before.
+     * @param origin The time of tick 0.
+     */
+    explicit TimingWheel(Clock::duration tick = std::chrono::milliseconds(1), Clock::time_point origin = Clock::now())
+        : _tick(tick), _origin(origin), _current(0), _size(0), _nodes(), _free(kNil), _heads(), _occupied() {
+        _heads.fill(kNil);
+        _occupied.fill(0);
+    }
+
+    /**
+     * @brief Schedule {element} to expire at {when}. A deadline in the past expires on the next advance().
+     *
+     */
+    template <typename U>
+    TimerId schedule(U&& element, const Clock::time_point& when) {
+        uint32_t index = _allocate();
+        Node& node = _nodes[index];
+        node.element.emplace(std::forward<U>(element));
+        node.expire = _ceil_tick(when);
+        _link(index);
+        ++_size;
+        return {index, node.generation};
+    }
+
+    /**
+     * @brief Cancel a pending timer.
+     *
+     * @return true if the timer was pending and is now gone, false if it already fired or was cancelled.
+     */
+    bool cancel(const TimerId& id) {
+        if ((!id.generation) || id.index >= _nodes.size() || _nodes[id.index].generation != id.generation) {
+            return false;
+        }
+        _unlink(id.index);
+        _release(id.index);
+        --_size;
+        return true;
+    }
+
+    /**
+     * @brief Advance the wheel to {now} and hand every expired element to {on_expired}, as an rvalue, tick by tick.
+     *
+     * @return the number of expired elements.
+     */
+    template <typename Callback>
+    size_t advance(const Clock::time_point& now, Callback&& on_expired) {
+        uint64_t target = _floor_tick(now);
+        size_t expired = 0;
+        if (_heads[kOverdue] != kNil) {
+            expired += _expire_bucket(kOverdue, on_expired);
+        }
+        if (!_size) {
+            _current = target > _current ? target : _current;
+            return expired;
+        }
+        while (_current <= target) {
+            size_t slot = _current & kMask;
+            if (!slot) {
+                _cascade();
+            }
+            uint64_t pending = _occupied[0] >> slot;
+            if (!pending) {
+                // Nothing left in this turn of level 0, skip to where the next cascade happens.
+                uint64_t next_turn = (_current | kMask) + 1;
+                _current = next_turn <= target ? next_turn : target + 1;
+                continue;
+            }
+            uint64_t tick = _current + static_cast<uint64_t>(__builtin_ctzll(pending));
+            if (tick > target) {
+                _current = target + 1;
+                break;
+            }
+            _current = tick;
+            _occupied[0] &= ~(uint64_t(1) << (tick & kMask));
+            expired += _expire_bucket(tick & kMask, on_expired);
+            ++_current;
+        }
+        return expired;
+    }
+
+    /**
+     * @brief The earliest time advance() may have anything to do: the next expiry in level 0 or the next cascade of a
+     * non-empty higher slot, whichever comes first. Sleeping until then never misses a timer.
+     *
+     * @return false if no timer is pending.
+     */
+    bool next_expiry(Clock::time_point& when) const {
+        if (!_size) {
+            return false;
+        }
+        uint64_t earliest = UINT64_MAX;
+        if (_heads[kOverdue] != kNil) {
+            earliest = 0;
+        }
+        for (size_t level = 0; level < kLevels; ++level) {
+            if (!_occupied[level]) {
+                continue;
+            }
+            size_t shift = level * kBits;
+            uint64_t position = _current >> shift;
+            size_t slot = position & kMask;
+            // Level 0 fires the slot we are in. A higher level cascades its current slot when we reach the start of it,
+            // after that whatever sits there belongs to the next turn.
+            bool at_start = !(_current & ((uint64_t(1) << shift) - 1));
+            size_t first = at_start ? slot : slot + 1;
+            uint64_t ahead = first < kSlots ? (_occupied[level] >> first) : 0;
+            uint64_t distance = 0;
+            if (ahead) {
+                distance = first - slot + static_cast<uint64_t>(__builtin_ctzll(ahead));
+            } else {
+                distance = kSlots - slot + static_cast<uint64_t>(__builtin_ctzll(_occupied[level]));
+            }
+            uint64_t tick = level ? (position + distance) << shift : _current + distance;
+            earliest = tick < earliest ? tick : earliest;
+        }
+        when = _origin + _tick * static_cast<Clock::rep>(earliest);
+        return true;
+    }
+
+    /**
+     * @brief Drop every pending timer. Their ids stay invalid, the slab is kept for reuse.
+     *
+     */
+    void clear() {
+        for (uint32_t index = 0; index < _nodes.size(); ++index) {
+            if (_nodes[index].generation & 1) {
+                _release(index);
+            }
+        }
+        _heads.fill(kNil);
+        _occupied.fill(0);
+        _size = 0;
+    }
+
+    size_t size() const { return _size; }
+
+    bool empty() const { return !_size; }
+
+private:
+    static constexpr size_t kBits = 6;
+    static constexpr size_t kSlots = size_t(1) << kBits;
+    static constexpr uint64_t kMask = kSlots - 1;
+    static constexpr size_t kLevels = 4;
+    static constexpr uint64_t kRange = uint64_t(1) << (kBits * kLevels);
+    static constexpr uint32_t kNil = UINT32_MAX;
+    static constexpr size_t kOverdue = kLevels * kSlots;  // timers scheduled behind the current tick
+
+    struct Node {
+        std::optional<T> element;
+        uint64_t expire = 0;
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t bucket = 0;      // level * kSlots + slot or kOverdue, to fix up the list head on unlink
+        uint32_t generation = 1;  // odd while scheduled, even while free
+    };
+
+    uint64_t _floor_tick(const Clock::time_point& when) const {
+        return when <= _origin ? 0 : static_cast<uint64_t>((when - _origin) / _tick);
+    }
+
+    uint64_t _ceil_tick(const Clock::time_point& when) const {
+        if (when <= _origin) {
+            return 0;
+        }
+        auto elapsed = when - _origin;
+        uint64_t tick = static_cast<uint64_t>(elapsed / _tick);
+        return (elapsed % _tick).count() ? tick + 1 : tick;
+    }
+
+    uint32_t _allocate() {
+        if (_free != kNil) {
+            uint32_t index = _free;
+            _free = _nodes[index].next;
+            ++_nodes[index].generation;
+            return index;
+        }
+        _nodes.emplace_back();
+        return static_cast<uint32_t>(_nodes.size() - 1);
+    }
+
+    void _release(uint32_t index) {
+        Node& node = _nodes[index];
+        node.element.reset();
+        ++node.generation;
+        node.next = _free;
+        _free = index;
+    }
+
+    void _link(uint32_t index) {
+        Node& node = _nodes[index];
+        size_t bucket = kOverdue;
+        if (node.expire >= _current) {
+            uint64_t expire = node.expire;
+            uint64_t delta = expire - _current;
+            if (delta >= kRange) {
+                expire = _current + kRange - 1;
+                delta = kRange - 1;
+            }
+            size_t level = 0;
+            while (delta >= (uint64_t(1) << (kBits * (level + 1)))) {
+                ++level;
+            }
+            size_t slot = (expire >> (kBits * level)) & kMask;
+            bucket = level * kSlots + slot;
+            _occupied[level] |= (uint64_t(1) << slot);
+        }
+        node.bucket = static_cast<uint32_t>(bucket);
+        node.prev = kNil;
+        node.next = _heads[bucket];
+        if (node.next != kNil) {
+            _nodes[node.next].prev = index;
+        }
+        _heads[bucket] = index;
+    }
+
+    void _unlink(uint32_t index) {
+        Node& node = _nodes[index];
+        if (node.prev != kNil) {
+            _nodes[node.prev].next = node.next;
+        } else {
+            _heads[node.bucket] = node.next;
+            if (node.next == kNil && node.bucket != kOverdue) {
+                _occupied[node.bucket / kSlots] &= ~(uint64_t(1) << (node.bucket % kSlots));
+            }
+        }
+        if (node.next != kNil) {
+            _nodes[node.next].prev = node.prev;
+        }
+    }
+
+    // Take the whole list of a bucket out of the wheel.
+    uint32_t _detach(size_t level, size_t slot) {
+        size_t bucket = level * kSlots + slot;
+        uint32_t head = _heads[bucket];
+        _heads[bucket] = kNil;
+        _occupied[level] &= ~(uint64_t(1) << slot);
+        return head;
+    }
+
+    void _cascade() {
+        for (size_t level = 1; level < kLevels; ++level) {
+            size_t slot = (_current >> (kBits * level)) & kMask;
+            uint32_t index = _detach(level, slot);
+            while (index != kNil) {
+                uint32_t next = _nodes[index].next;
+                _link(index);
+                index = next;
+            }
+            if (slot) {
+                break;
+            }
+        }
+    }
+
+    template <typename Callback>
+    size_t _expire_bucket(size_t bucket, Callback& on_expired) {
+        size_t expired = 0;
+        uint32_t index = _heads[bucket];
+        _heads[bucket] = kNil;
+        while (index != kNil) {
+            uint32_t next = _nodes[index].next;
+            T element = std::move(*_nodes[index].element);
+            _release(index);
+            --_size;
+            ++expired;
+            on_expired(std::move(element));
+            index = next;
+        }
+        return expired;
+    }
+
+private:
+    const Clock::duration _tick;
+    const Clock::time_point _origin;
+    uint64_t _current;  // the next tick to process
+    size_t _size;
+    std::vector<Node> _nodes;
+    uint32_t _free;
+    std::array<uint32_t, kLevels * kSlots + 1> _heads;
+    std::array<uint64_t, kLevels> _occupied;  // one bit per non-empty slot
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_TIMING_WHEEL_HPP
@@ -0,0 +1,111 @@
+/**
+ * @file triple_buffer.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A wait-free triple buffer handing the latest state from one writer to one reader.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_TRIPLE_BUFFER_HPP
+#define CYBERTRON_BASE_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "noncopyable.hpp"
+#include "cache_aligned.hpp"
+
+namespace cybertron::base {
+template <typename T>
+/**
+ * @brief A triple buffer for state too large for a SeqLock, e.g. a whole telemetry snapshot. The writer fills the
+ * back buffer in place and publish()es it, the reader picks up the latest published buffer with update() and reads it
+ * in place. Both sides are wait-free and nothing is copied or allocated: three buffers are rotated by exchanging one
+ * atomic index. States published faster than the reader looks are skipped, as only the latest one matters.
+ *
+ * There is exactly one writer and one reader thread. To share read-mostly state with many readers, use RcuCell.
+ *
+ *      // writer                                  // reader
+ *      fill(buffer.write_buffer());               if (buffer.update()) {
+ *      buffer.publish();                              use(buffer.read_buffer());
+ *                                                 }
+ */
+class TripleBuffer : public Noncopyable {
+public:
+    explicit TripleBuffer(const T& value = T())
+        : _buffers{CacheAligned<T>(value), CacheAligned<T>(value), CacheAligned<T>(value)},
+          _back(0),
+          _middle(1),
+          _front(2) {}
+
+    /**
+     * @brief Writer side: the buffer to fill in place. It keeps whatever was written into it last, which need not be
+     * the latest state.
+     *
+     */
+    T& write_buffer() { return *_buffers[_back]; }
+
+    /**
+     * @brief Writer side: hand the filled buffer over to the reader and take a free one to write next.
+     *
+     */
+    void publish() {
+        uint8_t previous = _middle.exchange(static_cast<uint8_t>(_back | kDirty), std::memory_order_acq_rel);
+        _back = previous & kIndex;
+    }
+
+    /**
+     * @brief Writer side: copy {value} into the back buffer and publish it.
+     *
+     */
+    void write(const T& value) {
+        write_buffer() = value;
+        publish();
+    }
+
+    /**
+     * @brief Reader side: switch to the latest published state if there is a newer one.
+     *
+     * @return true if read_buffer() changed.
+     */
+    bool update() {
+        if (!(_middle.load(std::memory_order_relaxed) & kDirty)) {
+            return false;
+        }
+        uint8_t previous = _middle.exchange(_front, std::memory_order_acq_rel);
+        _front = previous & kIndex;
+        return true;
+    }
+
+    /**
+     * @brief Reader side: the state picked up by the last update().
+     *
+     */
+    const T& read_buffer() const { return *_buffers[_front]; }
+
+    /**
+     * @brief Reader side: update() and return the latest state.
+     *
+     */
+    const T& read() {
+        update();
+        return read_buffer();
+    }
+
+private:
+    static constexpr uint8_t kIndex = 0x3;
+    static constexpr uint8_t kDirty = 0x4;  // the middle buffer holds a state the reader has not taken yet
+
+    CacheAligned<T> _buffers[3];
+    uint8_t _back;                 // writer only
+    std::atomic<uint8_t> _middle;  // index of the buffer in between, or'ed with kDirty
+    uint8_t _front;                // reader only
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_TRIPLE_BUFFER_HPP
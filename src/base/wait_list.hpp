@@ -0,0 +1,184 @@
+/**
+ * @file wait_list.hpp
+ * @author FengWenxi (ThorfromAsgard@outlook.com)
+ * @brief A condition variable that parks each waiter on a node of its own, so one waiter can be woken alone.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * <========================================================================>
+ *          github page: https://github.com/ThorfromAsgard/cybertron
+ *                   © 2024 FengWenxi. All Rights Reserved.
+ * <========================================================================>
+ *
+ */
+#ifndef CYBERTRON_BASE_WAIT_LIST_HPP
+#define CYBERTRON_BASE_WAIT_LIST_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <condition_variable>
+
+#include "noncopyable.hpp"
+
+namespace cybertron::base {
+template <typename Condition>
+/**
+ * @brief A drop-in for a condition variable whose waiters each park a Waiter node holding a {Condition} of their own,
+ * in FIFO order, like the parked senders and receivers of Channel. notify_one() wakes the longest waiting one, and
+ * notify(waiter) wakes one particular waiter without disturbing the rest, e.g. the one whose stop_token was cancelled.
+ *
+ * #NOTE Every member, the notifications included, must be called with the mutex of the wait held: a node lives in the
+ * stack frame of its waiter and is gone as soon as the waiter returns.
+ */
+class WaitList : public Noncopyable {
+public:
+    class Waiter : public Noncopyable {
+    public:
+        Waiter() : _condition(), _list(nullptr), _prev(nullptr), _next(nullptr), _notified(false) {}
+
+    private:
+        friend class WaitList;
+
+        Condition _condition;
+        WaitList* _list;  // the list it is parked in, or nullptr
+        Waiter* _prev;
+        Waiter* _next;
+        bool _notified;  // taken off the list by notify_one() since it last parked
+    };
+
+    WaitList() : _head(nullptr), _tail(nullptr), _size(0) {}
+
+    template <typename Lock, typename Predicate>
+    void wait(Lock& lock, Predicate predicate) {
+        Waiter waiter;
+        wait_until(lock, waiter, std::chrono::steady_clock::time_point::max(), predicate);
+    }
+
+    template <typename Lock, typename Clock, typename Duration, typename Predicate>
+    bool wait_until(Lock& lock, const std::chrono::time_point<Clock, Duration>& deadline, Predicate predicate) {
+        Waiter waiter;
+        return wait_until(lock, waiter, deadline, predicate);
+    }
+
+    template <typename Lock, typename Rep, typename Period, typename Predicate>
+    bool wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout, Predicate predicate) {
+        return wait_until(lock, std::chrono::steady_clock::now() + timeout, predicate);
+    }
+
+    /**
+     * @brief Wait on the node of {waiter} until {predicate} holds or {deadline} passes. time_point::max() means
+     * forever. A notify_one() that reaches a waiter timing out is handed on to the next one, so it is never lost.
+     *
+     * @return the final value of {predicate}.
+     */
+    template <typename Lock, typename Clock, typename Duration, typename Predicate>
+    bool wait_until(Lock& lock, Waiter& waiter, const std::chrono::time_point<Clock, Duration>& deadline,
+                    Predicate predicate) {
+        while (!predicate()) {
+            _park(waiter);
+            bool expired = false;
+            if (deadline == std::chrono::time_point<Clock, Duration>::max()) {
+                waiter._condition.wait(lock);
+            } else {
+                expired = waiter._condition.wait_until(lock, deadline) == std::cv_status::timeout;
+            }
+            _unpark(waiter);
+            if (expired) {
+                if (predicate()) {
+                    return true;
+                }
+                pass_on(waiter);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void notify_one() {
+        if (Waiter* waiter = _head) {
+            _unpark(*waiter);
+            waiter->_notified = true;
+            waiter->_condition.notify_one();
+        }
+    }
+
+    void notify_all() {
+        while (Waiter* waiter = _head) {
+            _unpark(*waiter);
+            waiter->_condition.notify_one();
+        }
+    }
+
+    /**
+     * @brief Wake {waiter} alone, if it is parked in this list.
+     *
+     */
+    void notify(Waiter& waiter) {
+        if (waiter._list == this) {
+            _unpark(waiter);
+            waiter._condition.notify_one();
+        }
+    }
+
+    /**
+     * @brief Hand a notify_one() that reached {waiter} on to the next waiter. Call it when {waiter} gives up for a
+     * reason of its own, e.g. cancellation, although the predicate it was woken for may hold.
+     *
+     */
+    void pass_on(Waiter& waiter) {
+        if (waiter._notified) {
+            waiter._notified = false;
+            notify_one();
+        }
+    }
+
+    bool empty() const { return !_head; }
+
+    /**
+     * @brief The number of waiters parked right now, not counting those notified but not yet returned.
+     *
+     */
+    size_t size() const { return _size; }
+
+private:
+    void _park(Waiter& waiter) {
+        waiter._list = this;
+        waiter._notified = false;
+        waiter._prev = _tail;
+        waiter._next = nullptr;
+        if (_tail) {
+            _tail->_next = &waiter;
+        } else {
+            _head = &waiter;
+        }
+        _tail = &waiter;
+        ++_size;
+    }
+
+    // No-op unless {waiter} is still parked here; a notification may have taken it off already.
+    void _unpark(Waiter& waiter) {
+        if (waiter._list != this) {
+            return;
+        }
+        if (waiter._prev) {
+            waiter._prev->_next = waiter._next;
+        } else {
+            _head = waiter._next;
+        }
+        if (waiter._next) {
+            waiter._next->_prev = waiter._prev;
+        } else {
+            _tail = waiter._prev;
+        }
+        waiter._list = nullptr;
+        --_size;
+    }
+
+private:
+    Waiter* _head;
+    Waiter* _tail;
+    size_t _size;
+};
+
+}  // namespace cybertron::base
+#endif  // CYBERTRON_BASE_WAIT_LIST_HPP
@@ -0,0 +1,199 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <coroutine>
+
+#include <gtest/gtest.h>
+
+#include "async_queue.hpp"
+#include "blocking_queue.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+// A coroutine that starts eagerly and frees itself when it finishes.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Resumes coroutines on one worker thread.
+class ThreadExecutor {
+public:
+    ThreadExecutor() : _handles(), _worker([this] { _run(); }) {}
+
+    ~ThreadExecutor() { stop(); }
+
+    void post(std::coroutine_handle<> handle) { _handles.push_back(handle); }
+
+    void stop() {
+        if (_worker.joinable()) {
+            while (!_handles.empty()) {
+                std::this_thread::yield();
+            }
+            _handles.close();
+            _worker.join();
+        }
+    }
+
+private:
+    void _run() {
+        std::coroutine_handle<> handle;
+        while (_handles.pop_front(handle)) {
+            handle.resume();
+        }
+    }
+
+    BlockingQueue<std::coroutine_handle<>> _handles;
+    std::thread _worker;
+};
+
+template <typename Queue>
+Detached consume(Queue& queue, std::vector<int>& out) {
+    while (std::optional<int> value = co_await queue.pop()) {
+        out.push_back(*value);
+    }
+}
+
+template <typename Queue>
+Detached consume(Queue& queue, std::vector<int>& out, std::atomic<bool>& done) {
+    while (std::optional<int> value = co_await queue.pop()) {
+        out.push_back(*value);
+    }
+    done = true;
+}
+
+template <typename Queue>
+Detached produce(Queue& queue, int from, int to, std::vector<bool>& results) {
+    for (int i = from; i < to; ++i) {
+        results.push_back(co_await queue.push(i));
+    }
+}
+}  // namespace
+
+TEST(AsyncQueueTest, TryPushAndTryPopFromPlainCode) {
+    InlineExecutor executor;
+    AsyncQueue<int, InlineExecutor> queue(executor, 2);
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_FALSE(queue.try_push(3));
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.capacity(), 2u);
+    int value = 0;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST(AsyncQueueTest, SuspendedPopperResumesOnPush) {
+    InlineExecutor executor;
+    AsyncQueue<int, InlineExecutor> queue(executor);
+    std::vector<int> out;
+    consume(queue, out);
+    EXPECT_TRUE(out.empty());
+    queue.try_push(1);
+    queue.try_push(2);
+    EXPECT_EQ(out, (std::vector<int>{1, 2}));
+    EXPECT_EQ(queue.size(), 0u);
+    queue.close();
+}
+
+TEST(AsyncQueueTest, SuspendedPusherResumesWhenRoomFrees) {
+    InlineExecutor executor;
+    AsyncQueue<int, InlineExecutor> queue(executor, 1);
+    std::vector<bool> results;
+    produce(queue, 0, 3, results);
+    EXPECT_EQ(results, (std::vector<bool>{true}));
+    int value = -1;
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(results.size(), 3u);
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 2);
+}
+
+TEST(AsyncQueueTest, CloseResumesEveryoneWithFailure) {
+    InlineExecutor executor;
+    AsyncQueue<int, InlineExecutor> empty(executor);
+    AsyncQueue<int, InlineExecutor> full(executor, 1);
+    std::vector<int> out;
+    std::vector<bool> results;
+    consume(empty, out);
+    produce(full, 0, 2, results);
+    empty.close();
+    full.close();
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(results, (std::vector<bool>{true, false}));
+    EXPECT_FALSE(empty.try_push(1));
+}
+
+TEST(AsyncQueueTest, PlainThreadsFeedACoroutineOnAnotherThread) {
+    constexpr int kPerProducer = 10000;
+    ThreadExecutor executor;
+    AsyncQueue<int, ThreadExecutor> queue(executor, 8);
+    std::vector<int> out;
+    std::atomic<bool> done{false};
+    // Suspends at once on the empty queue; from then on it only ever resumes on the executor's thread.
+    consume(queue, out, done);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < kPerProducer;) {
+                if (queue.try_push(1)) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    while (queue.size()) {
+        std::this_thread::yield();
+    }
+    queue.close();
+    while (!done) {
+        std::this_thread::yield();
+    }
+    executor.stop();
+    EXPECT_EQ(out.size(), 2u * kPerProducer);
+}
+
+TEST(AsyncQueueTest, DestroyingWithSuspendedWaitersTerminates) {
+    using Queue = AsyncQueue<int, InlineExecutor>;
+    auto destroy_with_popper = [] {
+        InlineExecutor executor;
+        std::vector<int> out;
+        Queue queue(executor);
+        consume(queue, out);
+    };
+    auto destroy_with_pusher = [] {
+        InlineExecutor executor;
+        std::vector<bool> results;
+        Queue queue(executor, 1);
+        produce(queue, 0, 2, results);
+    };
+    EXPECT_DEATH(destroy_with_popper(), "close\\(\\) or drain it first");
+    EXPECT_DEATH(destroy_with_pusher(), "close\\(\\) or drain it first");
+}
+
+TEST(AsyncQueueTest, DestroyingAfterCloseIsFine) {
+    InlineExecutor executor;
+    std::vector<int> out;
+    {
+        AsyncQueue<int, InlineExecutor> queue(executor);
+        consume(queue, out);
+        queue.try_push(1);
+        queue.close();
+    }
+    EXPECT_EQ(out, (std::vector<int>{1}));
+}
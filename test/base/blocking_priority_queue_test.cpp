@@ -0,0 +1,103 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "blocking_priority_queue.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+struct Level {
+    size_t operator()(int value) const { return static_cast<size_t>(value / 10); }
+};
+}  // namespace
+
+TEST(BlockingPriorityQueueTest, PopsTheHighestFirst) {
+    BlockingPriorityQueue<int> queue(8);
+    for (int value : {3, 9, 1, 7}) {
+        ASSERT_TRUE(queue.push(value));
+    }
+    EXPECT_EQ(queue.top(), 9);
+    int value = 0;
+    for (int expected : {9, 7, 3, 1}) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(BlockingPriorityQueueTest, FullNonBlockingQueueShedsTheLowest) {
+    BlockingPriorityQueue<int> queue(2, false);
+    queue.push(5);
+    queue.push(6);
+    EXPECT_FALSE(queue.push(1));  // does not outrank anything held
+    EXPECT_TRUE(queue.push(8));   // replaces 5
+    int value = 0;
+    queue.pop(value);
+    EXPECT_EQ(value, 8);
+    queue.pop(value);
+    EXPECT_EQ(value, 6);
+}
+
+TEST(BlockingPriorityQueueTest, BlockingPushAndPopTimeOut) {
+    BlockingPriorityQueue<int> queue(1, true);
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop(value, 10000));
+    queue.push(1);
+    EXPECT_FALSE(queue.try_push(2));
+    EXPECT_FALSE(queue.push(2, 10000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(BlockingPriorityQueueTest, CloseWakesWaiters) {
+    BlockingPriorityQueue<int> queue(1, true);
+    std::thread consumer([&] {
+        int value = 0;
+        EXPECT_FALSE(queue.pop(value));
+    });
+    std::this_thread::sleep_for(10ms);
+    queue.close();
+    consumer.join();
+    EXPECT_FALSE(queue.push(1));
+}
+
+TEST(BlockingBucketQueueTest, FifoWithinALevel) {
+    BlockingBucketQueue<int, 4, Level> queue;
+    for (int value : {11, 2, 12, 31, 13}) {
+        queue.push(value);
+    }
+    int value = 0;
+    for (int expected : {31, 11, 12, 13, 2}) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+}
+
+TEST(BlockingBucketQueueTest, ConcurrentProducersLoseNothing) {
+    constexpr int kPerProducer = 10000;
+    BlockingBucketQueue<int, 4, Level, FutexLockPolicy> queue(32, true);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 3; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                ASSERT_TRUE(queue.push(p * 10 + 1));
+            }
+        });
+    }
+    long sum = 0;
+    int value = 0;
+    for (int i = 0; i < 3 * kPerProducer; ++i) {
+        ASSERT_TRUE(queue.pop(value));
+        sum += value;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(sum, static_cast<long>(kPerProducer) * (1 + 11 + 21));
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,913 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <stop_token>
+#include <vector>
+
+#include <poll.h>
+
+#include <gtest/gtest.h>
+
+#include "blocking_queue.hpp"
+#include "memory_budget.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+int64_t elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool readable(int fd, int timeout_ms = 0) {
+    pollfd event{fd, POLLIN, 0};
+    return ::poll(&event, 1, timeout_ms) == 1 && (event.revents & POLLIN);
+}
+}  // namespace
+
+TEST(BlockingQueueTest, PushBackPopFrontIsFifo) {
+    BlockingQueue<int> queue(8);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.push_back(i));
+    }
+    EXPECT_EQ(queue.size(), 5u);
+    EXPECT_EQ(queue.front(), 0);
+    EXPECT_EQ(queue.back(), 4);
+    for (int i = 0; i < 5; ++i) {
+        int value = -1;
+        ASSERT_TRUE(queue.pop_front(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BlockingQueueTest, BothEnds) {
+    BlockingQueue<int> queue(8);
+    queue.push_back(1);
+    queue.push_front(0);
+    queue.push_back(2);
+    int value = -1;
+    ASSERT_TRUE(queue.pop_back(value));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(queue.pop_back(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(queue.pop_front(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(queue.pop_front(value, 1000));
+}
+
+TEST(BlockingQueueTest, NonBlockingModeDropsTheOldest) {
+    BlockingQueue<int> queue(3, false);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.push_back(i));
+    }
+    EXPECT_TRUE(queue.full());
+    int value = -1;
+    queue.pop_front(value);
+    EXPECT_EQ(value, 2);
+    // Pushing to the front drops from the back.
+    queue.push_front(10);
+    queue.push_front(11);
+    EXPECT_EQ(queue.front(), 11);
+    EXPECT_EQ(queue.back(), 3);
+}
+
+TEST(BlockingQueueTest, BlockingPushTimesOutWhenFull) {
+    BlockingQueue<int> queue(2, true);
+    ASSERT_TRUE(queue.push_back(1));
+    ASSERT_TRUE(queue.push_back(2));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.push_back(3, 20000));
+    EXPECT_GE(elapsed_ms(start), 15);
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST(BlockingQueueTest, PopTimesOutWhenEmpty) {
+    BlockingQueue<int> queue(2);
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop_front(value, 20000));
+    EXPECT_GE(elapsed_ms(start), 15);
+}
+
+TEST(BlockingQueueTest, BlockedProducerResumesAfterPop) {
+    BlockingQueue<int> queue(1, true);
+    queue.push_back(1);
+    std::thread producer([&] { EXPECT_TRUE(queue.push_back(2)); });
+    std::this_thread::sleep_for(10ms);
+    int value = 0;
+    ASSERT_TRUE(queue.pop_front(value));
+    producer.join();
+    ASSERT_TRUE(queue.pop_front(value, 100000));
+    EXPECT_EQ(value, 2);
+}
+
+TEST(BlockingQueueTest, CloseWakesEveryWaiter) {
+    BlockingQueue<int> empty(1);
+    BlockingQueue<int> full(1, true);
+    full.push_back(0);
+    std::thread consumer([&] {
+        int value = 0;
+        EXPECT_FALSE(empty.pop_front(value));
+    });
+    std::thread producer([&] { EXPECT_FALSE(full.push_back(1)); });
+    std::this_thread::sleep_for(10ms);
+    empty.close();
+    full.close();
+    consumer.join();
+    producer.join();
+    int value = 0;
+    EXPECT_FALSE(empty.pop_front(value, 1000));
+    EXPECT_TRUE(full.empty());
+    EXPECT_FALSE(full.push_back(2));
+}
+
+TEST(BlockingQueueTest, ClearEmptiesAndUnblocksProducers) {
+    BlockingQueue<int> queue(1, true);
+    queue.push_back(1);
+    std::thread producer([&] { EXPECT_TRUE(queue.push_back(2)); });
+    std::this_thread::sleep_for(10ms);
+    queue.clear();
+    producer.join();
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_EQ(queue.front(), 2);
+}
+
+TEST(BlockingQueueTest, ConcurrentProducersAndConsumersLoseNothing) {
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr int kPerProducer = 20000;
+    BlockingQueue<int> queue(64, true);
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&] {
+            for (int i = 1; i <= kPerProducer; ++i) {
+                ASSERT_TRUE(queue.push_back(i));
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            int value = 0;
+            while (queue.pop_front(value)) {
+                sum += value;
+                if (++popped == kProducers * kPerProducer) {
+                    queue.close();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(popped.load(), kProducers * kPerProducer);
+    EXPECT_EQ(sum.load(), static_cast<long long>(kProducers) * kPerProducer * (kPerProducer + 1) / 2);
+}
+
+TEST(BlockingQueueTest, FutexLockPolicyUnderContention) {
+    constexpr int kPerProducer = 20000;
+    BlockingQueue<int, FutexLockPolicy> queue(16, true);
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&] {
+            for (int i = 1; i <= kPerProducer; ++i) {
+                ASSERT_TRUE(queue.push_back(i));
+            }
+        });
+    }
+    std::thread consumer([&] {
+        int value = 0;
+        for (int i = 0; i < 2 * kPerProducer; ++i) {
+            ASSERT_TRUE(queue.pop_front(value));
+            sum += value;
+        }
+    });
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+    EXPECT_EQ(sum.load(), static_cast<long long>(kPerProducer) * (kPerProducer + 1));
+    int value = 0;
+    EXPECT_FALSE(queue.pop_front(value, 1000));
+}
+
+TEST(BlockingQueueTest, MoveOnlyElements) {
+    BlockingQueue<std::unique_ptr<int>> queue(2);
+    queue.push_back(std::make_unique<int>(7));
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(queue.pop_front(value));
+    EXPECT_EQ(*value, 7);
+}
+
+TEST(BlockingQueueTest, NoEventFdUnlessAsked) {
+    BlockingQueue<int> queue(4);
+    EXPECT_EQ(queue.event_fd(), -1);
+}
+
+TEST(BlockingQueueTest, EventFdIsReadableExactlyWhileNonEmpty) {
+    BlockingQueue<int> queue(4, false, true);
+    ASSERT_GE(queue.event_fd(), 0);
+    EXPECT_FALSE(readable(queue.event_fd()));
+    queue.push_back(1);
+    queue.push_back(2);
+    EXPECT_TRUE(readable(queue.event_fd()));
+    int value = 0;
+    queue.pop_front(value);
+    EXPECT_TRUE(readable(queue.event_fd()));
+    queue.try_pop_front(value);
+    EXPECT_FALSE(readable(queue.event_fd()));
+    queue.push_back(3);
+    queue.clear();
+    EXPECT_FALSE(readable(queue.event_fd()));
+}
+
+TEST(BlockingQueueTest, EventFdStaysReadableAfterClose) {
+    BlockingQueue<int> queue(4, false, true);
+    queue.close();
+    EXPECT_TRUE(readable(queue.event_fd()));
+}
+
+TEST(BlockingQueueTest, TryPopsTakeEitherEndWithoutBlocking) {
+    BlockingQueue<int> queue(4);
+    int value = -1;
+    EXPECT_FALSE(queue.try_pop_front(value));
+    EXPECT_FALSE(queue.try_pop_back(value));
+    queue.push_back(1);
+    queue.push_back(2);
+    ASSERT_TRUE(queue.try_pop_back(value));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(queue.try_pop_front(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(queue.closed());
+    queue.close();
+    EXPECT_TRUE(queue.closed());
+}
+
+TEST(BlockingQueueTest, EventFdWakesAPollingConsumer) {
+    constexpr int kItems = 20000;
+    BlockingQueue<int> queue(64, true, true);
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            ASSERT_TRUE(queue.push_back(i));
+        }
+    });
+    int expected = 0;
+    while (expected < kItems) {
+        ASSERT_TRUE(readable(queue.event_fd(), 1000));
+        int value = 0;
+        while (queue.try_pop_front(value)) {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(readable(queue.event_fd()));
+}
+
+TEST(BlockingQueueTest, DeadlineOverloadsGiveUpAtTheDeadline) {
+    BlockingQueue<int> queue(1, true);
+    int value = 0;
+    auto deadline = std::chrono::steady_clock::now() + 20ms;
+    EXPECT_FALSE(queue.pop_front(value, deadline));
+    EXPECT_GE(std::chrono::steady_clock::now(), deadline);
+    ASSERT_TRUE(queue.push_back(1, std::chrono::steady_clock::time_point::max()));
+    EXPECT_FALSE(queue.push_back(2, std::chrono::steady_clock::now() + 10ms));
+    ASSERT_TRUE(queue.pop_back(value, std::chrono::steady_clock::now() + 10ms));
+    EXPECT_EQ(value, 1);
+}
+
+TEST(BlockingQueueTest, StopCancelsOnlyItsOwnWaiter) {
+    BlockingQueue<int> queue(4);
+    std::stop_source cancelled;
+    std::stop_source untouched;
+    std::atomic<int> received{0};
+    std::thread victim([&] {
+        int value = 0;
+        EXPECT_FALSE(queue.pop_front(value, cancelled.get_token()));
+    });
+    std::vector<std::thread> others;
+    for (int i = 0; i < 2; ++i) {
+        others.emplace_back([&] {
+            int value = 0;
+            if (queue.pop_front(value, untouched.get_token())) {
+                ++received;
+            }
+        });
+    }
+    std::this_thread::sleep_for(20ms);
+    cancelled.request_stop();
+    victim.join();
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(received.load(), 0);
+    queue.push_back(1);
+    queue.push_back(2);
+    for (auto& other : others) {
+        other.join();
+    }
+    EXPECT_EQ(received.load(), 2);
+}
+
+TEST(BlockingQueueTest, StopBeforeTheCallReturnsAtOnce) {
+    BlockingQueue<int> queue(1, true);
+    queue.push_back(0);
+    std::stop_source source;
+    source.request_stop();
+    int value = 0;
+    EXPECT_FALSE(queue.push_back(1, source.get_token()));
+    EXPECT_FALSE(queue.pop_front(value, source.get_token()));
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(BlockingQueueTest, StopCancelsAProducerWaitingForTheBudget) {
+    MemoryBudget budget(8);
+    BlockingQueue<int> first(0, true);
+    BlockingQueue<int> second(0, true);
+    first.set_byte_capacity(0, [](const int&) { return size_t(8); }, &budget);
+    second.set_byte_capacity(0, [](const int&) { return size_t(8); }, &budget);
+    ASSERT_TRUE(first.push_back(1));
+    std::stop_source source;
+    std::thread producer([&] { EXPECT_FALSE(second.push_back(2, source.get_token())); });
+    std::this_thread::sleep_for(20ms);
+    source.request_stop();
+    producer.join();
+    EXPECT_EQ(budget.used(), 8u);
+    EXPECT_TRUE(second.empty());
+}
+
+TEST(BlockingQueueTest, CancellingWaitersUnderLoadLosesNoElement) {
+    constexpr int kItems = 20000;
+    BlockingQueue<int, FutexLockPolicy> queue(8, true);
+    std::atomic<int> popped{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 3; ++c) {
+        consumers.emplace_back([&] {
+            int value = 0;
+            while (!done) {
+                // Each pop gets its own token, cancelled shortly after by a helper thread half of the time.
+                std::stop_source source;
+                std::thread canceller;
+                if (popped % 2) {
+                    canceller = std::thread([&] {
+                        std::this_thread::yield();
+                        source.request_stop();
+                    });
+                }
+                if (queue.pop_front(value, source.get_token(), std::chrono::steady_clock::now() + 50ms)) {
+                    ++popped;
+                }
+                if (canceller.joinable()) {
+                    canceller.join();
+                }
+            }
+        });
+    }
+    for (int i = 0; i < kItems; ++i) {
+        ASSERT_TRUE(queue.push_back(i));
+    }
+    while (popped < kItems) {
+        std::this_thread::sleep_for(1ms);
+    }
+    done = true;
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(popped.load(), kItems);
+}
+
+TEST(BlockingQueueTest, PopBatchTakesWhatIsQueuedWithoutLinger) {
+    BlockingQueue<int> queue(8);
+    for (int i = 0; i < 5; ++i) {
+        queue.push_back(i);
+    }
+    std::vector<int> out;
+    EXPECT_EQ(queue.pop_batch(out, 3, 0), 3u);
+    EXPECT_EQ(out, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(queue.pop_batch(out, 10, 0), 2u);
+    EXPECT_EQ(out.size(), 5u);
+    EXPECT_EQ(queue.pop_batch(out, 0, 0), 0u);
+}
+
+TEST(BlockingQueueTest, PopBatchTimesOutOnAnEmptyQueue) {
+    BlockingQueue<int> queue(8);
+    std::vector<int> out;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.pop_batch(out, 4, 1000, 20000), 0u);
+    EXPECT_GE(elapsed_ms(start), 15);
+}
+
+TEST(BlockingQueueTest, PopBatchLingersToFillTheBatch) {
+    BlockingQueue<int> queue(8);
+    queue.push_back(0);
+    std::thread producer([&] {
+        std::this_thread::sleep_for(10ms);
+        queue.push_back(1);
+        queue.push_back(2);
+    });
+    std::vector<int> out;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.pop_batch(out, 3, 1000000), 3u);
+    EXPECT_LT(elapsed_ms(start), 1000);
+    producer.join();
+}
+
+TEST(BlockingQueueTest, PopBatchReturnsAPartialBatchAfterTheLinger) {
+    BlockingQueue<int> queue(8);
+    queue.push_back(0);
+    std::vector<int> out;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.pop_batch(out, 3, 20000), 1u);
+    EXPECT_GE(elapsed_ms(start), 15);
+}
+
+TEST(BlockingQueueTest, PopBatchDrainsAFullQueueWhileLingering) {
+    BlockingQueue<int> queue(2, true);
+    queue.push_back(0);
+    // The rest of the batch never fits in a queue of 2: the lingering consumer has to drain it whenever it fills up,
+    // or this producer would stay blocked until the linger ends.
+    std::thread producer([&] {
+        for (int i = 1; i < 5; ++i) {
+            queue.push_back(i);
+        }
+    });
+    std::vector<int> out;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.pop_batch(out, 5, 1000000), 5u);
+    EXPECT_LT(elapsed_ms(start), 1000);
+    EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4}));
+    producer.join();
+}
+
+TEST(BlockingQueueTest, BatchAndPlainConsumersShareTheLoad) {
+    constexpr int kItems = 40000;
+    BlockingQueue<int> queue(32, true);
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0};
+    std::thread batcher([&] {
+        std::vector<int> out;
+        while (popped < kItems) {
+            out.clear();
+            size_t count = queue.pop_batch(out, 16, 200, 10000);
+            for (int value : out) {
+                sum += value;
+            }
+            popped += static_cast<int>(count);
+        }
+    });
+    std::thread plain([&] {
+        int value = 0;
+        while (popped < kItems) {
+            if (queue.pop_front(value, 10000)) {
+                sum += value;
+                ++popped;
+            }
+        }
+    });
+    for (int i = 1; i <= kItems; ++i) {
+        ASSERT_TRUE(queue.push_back(i));
+    }
+    batcher.join();
+    plain.join();
+    EXPECT_EQ(popped.load(), kItems);
+    EXPECT_EQ(sum.load(), static_cast<long long>(kItems) * (kItems + 1) / 2);
+}
+
+namespace {
+// Elements stand for their own size in bytes.
+size_t own_size(const int& element) { return static_cast<size_t>(element); }
+}  // namespace
+
+TEST(BlockingQueueTest, HopelessBudgetPushEvictsNothing) {
+    MemoryBudget budget(100);
+    BlockingQueue<int> other(0, true);
+    BlockingQueue<int> queue(0, false, true);
+    other.set_byte_capacity(0, own_size, &budget);
+    queue.set_byte_capacity(0, own_size, &budget);
+    ASSERT_TRUE(other.push_back(75));
+    ASSERT_TRUE(queue.push_back(10));
+    ASSERT_TRUE(queue.push_back(10));
+    // Even an empty queue leaves only 25 bytes of the budget, so shedding its elements would gain nothing.
+    EXPECT_FALSE(queue.push_back(30));
+    EXPECT_FALSE(queue.try_push_back(30));
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.bytes(), 20u);
+    EXPECT_EQ(budget.used(), 95u);
+    EXPECT_TRUE(readable(queue.event_fd()));
+}
+
+TEST(BlockingQueueTest, NonBlockingPushShedsItsOwnElementsForTheBudget) {
+    MemoryBudget budget(100);
+    BlockingQueue<int> other(0, true);
+    BlockingQueue<int> queue(0, false, true);
+    other.set_byte_capacity(0, own_size, &budget);
+    queue.set_byte_capacity(0, own_size, &budget);
+    ASSERT_TRUE(other.push_back(75));
+    ASSERT_TRUE(queue.push_back(10));
+    ASSERT_TRUE(queue.push_back(10));
+    EXPECT_TRUE(queue.push_back(25));
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_EQ(queue.front(), 25);
+    EXPECT_EQ(budget.used(), 100u);
+    int value = 0;
+    queue.pop_front(value);
+    EXPECT_FALSE(readable(queue.event_fd()));
+    EXPECT_EQ(budget.used(), 75u);
+}
+
+TEST(BlockingQueueTest, ByteCapacityBoundsTheQueue) {
+    BlockingQueue<int> queue(0, true);
+    queue.set_byte_capacity(20, own_size);
+    EXPECT_EQ(queue.byte_capacity(), 20u);
+    ASSERT_TRUE(queue.push_back(15));
+    EXPECT_FALSE(queue.try_push_back(10));
+    EXPECT_TRUE(queue.try_push_back(5));
+    EXPECT_EQ(queue.bytes(), 20u);
+    EXPECT_FALSE(queue.push_back(1, 10000));
+    int value = 0;
+    queue.pop_front(value);
+    queue.pop_front(value);
+    // An element larger than the whole capacity still fits into an empty queue.
+    EXPECT_TRUE(queue.try_push_back(50));
+}
+
+TEST(BlockingQueueTest, BlockingProducerWaitsForTheSharedBudget) {
+    MemoryBudget budget(10);
+    BlockingQueue<int> first(0, true);
+    BlockingQueue<int> second(0, true);
+    first.set_byte_capacity(0, own_size, &budget);
+    second.set_byte_capacity(0, own_size, &budget);
+    ASSERT_TRUE(first.push_back(8));
+    EXPECT_FALSE(second.push_back(5, 10000));
+    std::thread producer([&] { EXPECT_TRUE(second.push_back(5)); });
+    std::this_thread::sleep_for(10ms);
+    int value = 0;
+    first.pop_front(value);
+    producer.join();
+    EXPECT_EQ(budget.used(), 5u);
+}
+
+TEST(BlockingQueueTest, SharedBudgetIsNeverOverdrawnUnderContention) {
+    constexpr int kPerProducer = 5000;
+    MemoryBudget budget(64);
+    BlockingQueue<int, FutexLockPolicy> first(0, true);
+    BlockingQueue<int, FutexLockPolicy> second(0, true);
+    first.set_byte_capacity(0, own_size, &budget);
+    second.set_byte_capacity(0, own_size, &budget);
+    std::atomic<bool> overdrawn{false};
+    std::vector<std::thread> threads;
+    for (auto* queue : {&first, &second}) {
+        threads.emplace_back([queue] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                ASSERT_TRUE(queue->push_back(1 + i % 8));
+            }
+        });
+        threads.emplace_back([queue, &budget, &overdrawn] {
+            int value = 0;
+            for (int i = 0; i < kPerProducer; ++i) {
+                ASSERT_TRUE(queue->pop_front(value));
+                if (budget.used() > budget.limit()) {
+                    overdrawn = true;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(overdrawn.load());
+    EXPECT_EQ(budget.used(), 0u);
+}
+
+TEST(BlockingQueueTest, WatermarksHaveHysteresis) {
+    BlockingQueue<int> queue(0, true);
+    std::vector<bool> changes;
+    queue.set_watermarks(3, 1, [&](bool congested) { changes.push_back(congested); });
+    queue.push_back(1);
+    queue.push_back(2);
+    EXPECT_FALSE(queue.congested());
+    queue.push_back(3);
+    EXPECT_TRUE(queue.congested());
+    int value = 0;
+    queue.pop_front(value);
+    EXPECT_TRUE(queue.congested());
+    queue.pop_front(value);
+    EXPECT_FALSE(queue.congested());
+    queue.push_back(4);
+    EXPECT_EQ(changes, (std::vector<bool>{true, false}));
+    queue.set_watermarks(0, 0);
+    EXPECT_FALSE(queue.congested());
+}
+
+TEST(BlockingQueueTest, WatermarkCallbackMayReenterTheQueue) {
+    BlockingQueue<int> queue(0, true);
+    std::vector<bool> changes;
+    queue.set_watermarks(2, 0, [&](bool congested) {
+        changes.push_back(congested);
+        if (congested) {
+            // Re-arming from inside the callback must not deadlock.
+            queue.set_watermarks(3, 1, [&](bool again) { changes.push_back(again); });
+            int value = 0;
+            queue.try_pop_front(value);
+        }
+    });
+    queue.push_back(1);
+    queue.push_back(2);
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_FALSE(queue.congested());
+    EXPECT_EQ(changes, (std::vector<bool>{true, false}));
+}
+
+TEST(BlockingQueueTest, WatermarkCallbacksAlternateUnderContention) {
+    BlockingQueue<int, FutexLockPolicy> queue(0, true);
+    std::atomic<int> calls{0};
+    std::atomic<int> overlapping{0};
+    std::atomic<bool> broken{false};
+    bool last = false;
+    queue.set_watermarks(4, 1, [&](bool congested) {
+        if (overlapping.fetch_add(1) != 0 || congested == last) {
+            broken = true;
+        }
+        last = congested;
+        ++calls;
+        overlapping.fetch_sub(1);
+    });
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 20000; ++i) {
+                queue.push_back(i);
+            }
+        });
+        threads.emplace_back([&] {
+            int value = 0;
+            for (int i = 0; i < 20000; ++i) {
+                ASSERT_TRUE(queue.pop_front(value));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(broken.load());
+    EXPECT_FALSE(queue.congested());
+    EXPECT_EQ(last, false);
+}
+
+TEST(BlockingQueueTest, LastWatermarkCrossingIsAlwaysDelivered) {
+    constexpr int kRounds = 40;
+    constexpr int kPerThread = 2000;
+    BlockingQueue<int> queue(0, true);
+    std::atomic<bool> last{false};
+    queue.set_watermarks(4, 1, [&](bool congested) { last = congested; });
+    for (int round = 0; round < kRounds; ++round) {
+        // Even rounds leave 20 elements behind, well above the high watermark; odd rounds drain them again.
+        bool fill = round % 2 == 0;
+        int pushes = fill ? kPerThread : kPerThread - 10;
+        int pops = fill ? kPerThread - 10 : kPerThread;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 2; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < pushes; ++i) {
+                    queue.push_back(i);
+                }
+            });
+            threads.emplace_back([&] {
+                int value = 0;
+                for (int i = 0; i < pops; ++i) {
+                    ASSERT_TRUE(queue.pop_front(value));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        ASSERT_EQ(queue.congested(), fill);
+        ASSERT_EQ(last.load(), fill) << "round " << round;
+    }
+}
+
+TEST(BlockingQueueTest, PopsSkipExpiredElements) {
+    BlockingQueue<int> queue(8);
+    queue.push_back(0);  // pushed before expiry was set: never expires
+    queue.set_ttl(10ms);
+    queue.push_back(1);
+    queue.push_back(2);
+    std::this_thread::sleep_for(15ms);
+    queue.push_back(3);
+    int value = -1;
+    ASSERT_TRUE(queue.pop_front(value));
+    EXPECT_EQ(value, 0);
+    ASSERT_TRUE(queue.pop_front(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_EQ(queue.expired_count(), 2u);
+}
+
+TEST(BlockingQueueTest, ExpiryIsJudgedAtBothEnds) {
+    BlockingQueue<int> queue(8);
+    auto now = std::chrono::steady_clock::now();
+    queue.set_expiry([now](const int& value) { return value < 0 ? now : now + 1h; });
+    queue.push_back(1);
+    queue.push_back(-1);
+    queue.push_back(-2);
+    int value = 0;
+    ASSERT_TRUE(queue.pop_back(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(queue.expired_count(), 2u);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BlockingQueueTest, AllExpiredMakesAPopWait) {
+    BlockingQueue<int> queue(8);
+    queue.set_ttl(1ms);
+    queue.push_back(1);
+    std::this_thread::sleep_for(5ms);
+    int value = 0;
+    EXPECT_FALSE(queue.try_pop_front(value));
+    EXPECT_FALSE(queue.pop_front(value, 10000));
+    std::vector<int> out;
+    queue.push_back(2);
+    std::this_thread::sleep_for(5ms);
+    EXPECT_EQ(queue.pop_batch(out, 4, 0, 10000), 0u);
+    EXPECT_EQ(queue.expired_count(), 2u);
+}
+
+TEST(BlockingQueueTest, ExpiryReleasesBudgetAndRoom) {
+    MemoryBudget budget(0);
+    BlockingQueue<int> queue(1, true);
+    queue.set_byte_capacity(0, own_size, &budget);
+    queue.set_ttl(1ms);
+    queue.push_back(4);
+    std::this_thread::sleep_for(5ms);
+    int value = 0;
+    EXPECT_FALSE(queue.try_pop_front(value));
+    EXPECT_EQ(budget.used(), 0u);
+    EXPECT_TRUE(queue.try_push_back(5));
+}
+
+TEST(BlockingQueueTest, ExpiredElementsAreUnchargedWithoutMeasuringThem) {
+    MemoryBudget budget(0);
+    BlockingQueue<int> queue(8);
+    int measured = 0;
+    queue.set_byte_capacity(0, [&](const int& element) {
+        ++measured;
+        return own_size(element);
+    }, &budget);
+    queue.set_ttl(1ms);
+    queue.push_back(3);
+    queue.push_back(4);
+    queue.push_back(5);
+    EXPECT_EQ(measured, 3);
+    EXPECT_EQ(budget.used(), 12u);
+    std::this_thread::sleep_for(5ms);
+    int value = 0;
+    EXPECT_FALSE(queue.try_pop_front(value));
+    EXPECT_EQ(measured, 3);
+    EXPECT_EQ(queue.bytes(), 0u);
+    EXPECT_EQ(budget.used(), 0u);
+    EXPECT_EQ(queue.expired_count(), 3u);
+}
+
+TEST(BlockingQueueTest, ExpiredElementsAreCountedOnceUnderContention) {
+    constexpr int kItems = 20000;
+    BlockingQueue<int> queue(64, true);
+    // Odd elements are already expired when pushed.
+    queue.set_expiry([](const int& value) {
+        return value % 2 ? std::chrono::steady_clock::time_point::min() : std::chrono::steady_clock::time_point::max();
+    });
+    std::atomic<int> live{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c) {
+        consumers.emplace_back([&] {
+            int value = 0;
+            std::vector<int> out;
+            while (!done || !queue.empty()) {
+                if (queue.pop_front(value, 1000)) {
+                    ASSERT_EQ(value % 2, 0);
+                    ++live;
+                }
+                out.clear();
+                live += static_cast<int>(queue.pop_batch(out, 4, 0, 1000));
+            }
+        });
+    }
+    for (int i = 0; i < kItems; ++i) {
+        ASSERT_TRUE(queue.push_back(i));
+    }
+    done = true;
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(live.load(), kItems / 2);
+    EXPECT_EQ(queue.expired_count(), static_cast<uint64_t>(kItems / 2));
+}
+
+namespace {
+template <typename Policy>
+class BlockingQueueRwPolicyTest : public ::testing::Test {};
+
+using RwPolicies = ::testing::Types<RwSpinLockPolicy, DistributedRwLockPolicy>;
+TYPED_TEST_SUITE(BlockingQueueRwPolicyTest, RwPolicies);
+}  // namespace
+
+TYPED_TEST(BlockingQueueRwPolicyTest, BlocksAndTimesOut) {
+    BlockingQueue<int, TypeParam> queue(1, true);
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop_front(value, 20000));
+    EXPECT_GE(elapsed_ms(start), 20);
+    ASSERT_TRUE(queue.push_back(1));
+    EXPECT_FALSE(queue.push_back(2, 10000));
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(10ms);
+        int popped = 0;
+        EXPECT_TRUE(queue.pop_front(popped));
+        EXPECT_EQ(popped, 1);
+    });
+    EXPECT_TRUE(queue.push_back(2));
+    consumer.join();
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TYPED_TEST(BlockingQueueRwPolicyTest, ObserversRunAlongsideProducersAndConsumers) {
+    constexpr int kPerProducer = 20000;
+    BlockingQueue<int, TypeParam> queue(16, true);
+    std::atomic<bool> done{false};
+    std::atomic<int> oversized{0};
+    std::vector<std::thread> observers;
+    for (int o = 0; o < 2; ++o) {
+        observers.emplace_back([&] {
+            while (!done) {
+                if (queue.size() > 16) {
+                    ++oversized;
+                }
+                queue.empty();
+            }
+        });
+    }
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&] {
+            for (int i = 1; i <= kPerProducer; ++i) {
+                ASSERT_TRUE(queue.push_back(i));
+            }
+        });
+    }
+    std::thread consumer([&] {
+        int value = 0;
+        for (int i = 0; i < 2 * kPerProducer; ++i) {
+            ASSERT_TRUE(queue.pop_front(value));
+            sum += value;
+        }
+    });
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+    done = true;
+    for (auto& observer : observers) {
+        observer.join();
+    }
+    EXPECT_EQ(oversized.load(), 0);
+    EXPECT_EQ(sum.load(), static_cast<long long>(kPerProducer) * (kPerProducer + 1));
+}
+
+TYPED_TEST(BlockingQueueRwPolicyTest, WatermarkCallbacksAlternateUnderContention) {
+    BlockingQueue<int, TypeParam> queue(0, true);
+    std::atomic<int> calls{0};
+    std::atomic<int> overlapping{0};
+    std::atomic<bool> broken{false};
+    bool last = false;
+    queue.set_watermarks(4, 1, [&](bool congested) {
+        if (overlapping.fetch_add(1) != 0 || congested == last) {
+            broken = true;
+        }
+        last = congested;
+        ++calls;
+        overlapping.fetch_sub(1);
+    });
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 20000; ++i) {
+                queue.push_back(i);
+            }
+        });
+        threads.emplace_back([&] {
+            int value = 0;
+            for (int i = 0; i < 20000; ++i) {
+                ASSERT_TRUE(queue.pop_front(value));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(broken.load());
+    EXPECT_FALSE(queue.congested());
+    EXPECT_EQ(last, false);
+}
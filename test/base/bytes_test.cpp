@@ -0,0 +1,104 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "bytes.hpp"
+#include "blocking_queue.hpp"
+
+using namespace cybertron::base;
+
+TEST(BytesTest, EmptyByDefault) {
+    Bytes bytes;
+    EXPECT_TRUE(bytes.empty());
+    EXPECT_EQ(bytes.use_count(), 0u);
+    EXPECT_EQ(bytes.view(), "");
+    EXPECT_EQ(bytes, Bytes::copy(""));
+}
+
+TEST(BytesTest, CopiesShareTheBuffer) {
+    Bytes original = Bytes::copy("hello world");
+    EXPECT_EQ(original.use_count(), 1u);
+    {
+        Bytes copy = original;
+        EXPECT_EQ(copy.data(), original.data());
+        EXPECT_EQ(original.use_count(), 2u);
+        Bytes moved = std::move(copy);
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(original.use_count(), 2u);
+        EXPECT_EQ(moved, original);
+    }
+    EXPECT_EQ(original.use_count(), 1u);
+}
+
+TEST(BytesTest, SlicesNarrowTheViewWithoutCopying) {
+    Bytes message = Bytes::copy("header:payload");
+    Bytes payload = message.slice(7);
+    EXPECT_EQ(payload.view(), "payload");
+    EXPECT_EQ(payload.data(), message.data() + 7);
+    EXPECT_EQ(message.slice(0, 6).view(), "header");
+    EXPECT_EQ(message.slice(7, 100).size(), 7u);
+    EXPECT_TRUE(message.slice(message.size()).empty());
+    EXPECT_THROW(message.slice(message.size() + 1), std::out_of_range);
+    EXPECT_EQ(message.use_count(), 2u);
+
+    Bytes trimmed = message;
+    trimmed.remove_prefix(7);
+    trimmed.remove_suffix(3);
+    EXPECT_EQ(trimmed.view(), "payl");
+    EXPECT_EQ(trimmed[0], 'p');
+    trimmed.remove_suffix(100);
+    EXPECT_TRUE(trimmed.empty());
+    EXPECT_EQ(message.view(), "header:payload");
+}
+
+TEST(BytesTest, BuilderFreezesWithoutCopying) {
+    BytesBuilder builder(4);
+    EXPECT_EQ(builder.capacity(), 4u);
+    std::memcpy(builder.tail(), "ab", 2);
+    builder.commit(2);
+    EXPECT_EQ(builder.tailroom(), 2u);
+    builder.append("cdef");
+    EXPECT_GE(builder.capacity(), 6u);
+    const char* written = builder.data();
+    Bytes frozen = builder.freeze();
+    EXPECT_EQ(frozen.view(), "abcdef");
+    EXPECT_EQ(frozen.data(), written);
+    EXPECT_EQ(builder.size(), 0u);
+    EXPECT_EQ(builder.capacity(), 0u);
+    EXPECT_TRUE(builder.freeze().empty());
+    builder.commit(5);
+    EXPECT_EQ(builder.size(), 0u);
+}
+
+TEST(BytesTest, TravelsThroughAQueueByHandle) {
+    BlockingQueue<Bytes> queue(4);
+    Bytes message = Bytes::copy("payload");
+    ASSERT_TRUE(queue.push_back(message));
+    Bytes popped;
+    ASSERT_TRUE(queue.pop_front(popped));
+    EXPECT_EQ(popped.data(), message.data());
+    EXPECT_EQ(message.use_count(), 2u);
+}
+
+TEST(BytesTest, ViewsAreSharedAcrossThreads) {
+    Bytes message = Bytes::copy(std::string(1024, 'x'));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([message, t] {
+            for (int i = 0; i < 20000; ++i) {
+                Bytes part = message.slice(static_cast<size_t>(t + i % 100), 16);
+                Bytes copy = part;
+                ASSERT_EQ(copy.view(), std::string(16, 'x'));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(message.use_count(), 1u);
+}
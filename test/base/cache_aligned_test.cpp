@@ -0,0 +1,56 @@
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "cache_aligned.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+struct TwoCounters {
+    CacheAligned<std::atomic<uint64_t>> first;
+    CacheAligned<std::atomic<uint64_t>> second;
+};
+}  // namespace
+
+TEST(CacheAlignedTest, StartsOnItsOwnLine) {
+    CacheAligned<char> value('x');
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&*value) % hardware_destructive_interference_size, 0u);
+    EXPECT_EQ(sizeof(CacheAligned<char>) % hardware_destructive_interference_size, 0u);
+    EXPECT_EQ(*value, 'x');
+}
+
+TEST(CacheAlignedTest, NeighboursNeverShareALine) {
+    TwoCounters counters;
+    auto first = reinterpret_cast<uintptr_t>(&*counters.first);
+    auto second = reinterpret_cast<uintptr_t>(&*counters.second);
+    EXPECT_GE(second - first, hardware_destructive_interference_size);
+}
+
+TEST(CacheAlignedTest, ForwardsConstructorArgumentsAndAccess) {
+    CacheAligned<std::pair<int, int>> pair(1, 2);
+    EXPECT_EQ(pair->first, 1);
+    pair.get().second = 5;
+    EXPECT_EQ((*pair).second, 5);
+}
+
+TEST(PaddedTest, PadsBothSides) {
+    EXPECT_GE(sizeof(Padded<int>), 2 * hardware_destructive_interference_size + sizeof(int));
+    Padded<int> value(7);
+    EXPECT_EQ(*value, 7);
+    *value = 8;
+    EXPECT_EQ(value.get(), 8);
+}
+
+TEST(CacheAlignedTest, CopiesFromNonConstLvalues) {
+    CacheAligned<std::pair<int, int>> original(3, 4);
+    CacheAligned<std::pair<int, int>> copy(original);
+    EXPECT_EQ(copy->first, 3);
+    EXPECT_EQ(copy->second, 4);
+
+    Padded<int> padded(9);
+    Padded<int> padded_copy(padded);
+    EXPECT_EQ(*padded_copy, 9);
+}
@@ -0,0 +1,203 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "channel.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+// Condition variables whose notifications can be held back, to order a woken thread after another one.
+std::atomic<bool> hold_wakeups{false};
+
+class HoldableCondition : public std::condition_variable {
+public:
+    void notify_one() {
+        if (!hold_wakeups) {
+            std::condition_variable::notify_one();
+        }
+    }
+};
+
+struct HoldableLockPolicy {
+    using mutex_type = std::mutex;
+    using condition_type = HoldableCondition;
+};
+
+// Whether an lvalue of {Element} can be sent by copy, through send() and try_send().
+template <typename Element, typename = void>
+struct sends_copies : std::false_type {};
+
+template <typename Element>
+struct sends_copies<Element, std::void_t<decltype(std::declval<Channel<Element>&>().send(std::declval<Element&>())),
+                                         decltype(std::declval<Channel<Element>&>().try_send(
+                                             std::declval<Element&>()))>> : std::true_type {};
+}  // namespace
+
+TEST(ChannelTest, UnbufferedTrySendNeedsAWaitingReceiver) {
+    Channel<int> channel;
+    EXPECT_EQ(channel.capacity(), 0u);
+    EXPECT_FALSE(channel.try_send(1));
+    int value = 0;
+    EXPECT_FALSE(channel.try_receive(value));
+    std::thread receiver([&] {
+        int received = 0;
+        EXPECT_TRUE(channel.receive(received));
+        EXPECT_EQ(received, 2);
+    });
+    while (!channel.try_send(2)) {
+        std::this_thread::yield();
+    }
+    receiver.join();
+    EXPECT_EQ(channel.size(), 0u);
+}
+
+TEST(ChannelTest, UnbufferedSendWaitsForTheHandoff) {
+    Channel<int> channel;
+    std::atomic<bool> sent{false};
+    std::thread sender([&] {
+        EXPECT_TRUE(channel.send(3));
+        sent = true;
+    });
+    std::this_thread::sleep_for(10ms);
+    EXPECT_FALSE(sent.load());
+    int value = 0;
+    ASSERT_TRUE(channel.receive(value));
+    sender.join();
+    EXPECT_EQ(value, 3);
+}
+
+TEST(ChannelTest, BufferedActsAsABoundedQueue) {
+    Channel<int> channel(2);
+    EXPECT_TRUE(channel.try_send(1));
+    EXPECT_TRUE(channel.send(2));
+    EXPECT_FALSE(channel.try_send(3));
+    EXPECT_EQ(channel.size(), 2u);
+    int value = 0;
+    ASSERT_TRUE(channel.receive(value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST(ChannelTest, TimeoutsExpire) {
+    Channel<int> unbuffered;
+    Channel<int> full(1);
+    full.send(0);
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(unbuffered.send(1, 10000));
+    EXPECT_FALSE(unbuffered.receive(value, 10000));
+    EXPECT_FALSE(full.send(1, 10000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 25ms);
+    // A timed-out sender must not leave its element behind.
+    EXPECT_FALSE(unbuffered.try_receive(value));
+}
+
+TEST(ChannelTest, CloseFailsBlockedSendersAndReceivers) {
+    Channel<int> to_send;
+    Channel<int> to_receive;
+    std::thread sender([&] { EXPECT_FALSE(to_send.send(1)); });
+    std::thread receiver([&] {
+        int value = 0;
+        EXPECT_FALSE(to_receive.receive(value));
+    });
+    std::this_thread::sleep_for(10ms);
+    to_send.close();
+    to_receive.close();
+    sender.join();
+    receiver.join();
+    EXPECT_TRUE(to_send.closed());
+    EXPECT_FALSE(to_send.try_send(2));
+}
+
+TEST(ChannelTest, ReceiveAfterCloseDoesNotTakeFromBlockedSenders) {
+    Channel<int, HoldableLockPolicy> unbuffered;
+    Channel<int, HoldableLockPolicy> full(1);
+    full.send(0);
+    // The timeout only bounds the test should a sender wrongly complete while its wakeup is held back.
+    std::thread unbuffered_sender([&] { EXPECT_FALSE(unbuffered.send(1, 1000000)); });
+    std::thread full_sender([&] { EXPECT_FALSE(full.send(2, 1000000)); });
+    std::this_thread::sleep_for(10ms);
+    // Receive while the closed-out senders are still parked: the buffer drains, but nothing comes from the senders.
+    hold_wakeups = true;
+    unbuffered.close();
+    full.close();
+    int value = -1;
+    EXPECT_FALSE(unbuffered.receive(value));
+    ASSERT_TRUE(full.receive(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(full.receive(value));
+    hold_wakeups = false;
+    unbuffered.close();
+    full.close();
+    unbuffered_sender.join();
+    full_sender.join();
+}
+
+TEST(ChannelTest, MoveOnlyElements) {
+    Channel<std::unique_ptr<int>> channel(1);
+    EXPECT_TRUE(channel.send(std::make_unique<int>(4)));
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(channel.receive(value));
+    EXPECT_EQ(*value, 4);
+}
+
+TEST(ChannelTest, MoveOnlyElementsCannotBeSentByCopy) {
+    static_assert(sends_copies<int>::value);
+    static_assert(!sends_copies<std::unique_ptr<int>>::value);
+    Channel<std::unique_ptr<int>> unbuffered;
+    Channel<std::unique_ptr<int>> buffered(4);
+    auto element = std::make_unique<int>(5);
+    EXPECT_TRUE(buffered.try_send(std::move(element)));
+    std::unique_ptr<int> value;
+    std::thread receiver([&] { EXPECT_TRUE(unbuffered.receive(value)); });
+    ASSERT_TRUE(buffered.receive(element));
+    EXPECT_TRUE(unbuffered.send(std::move(element)));
+    receiver.join();
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 5);
+}
+
+class ChannelStressTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(ChannelStressTest, EveryElementArrivesOnce) {
+    constexpr int kSenders = 3;
+    constexpr int kPerSender = 5000;
+    Channel<int, FutexLockPolicy> channel(GetParam());
+    std::vector<std::atomic<int>> seen(kSenders * kPerSender);
+    std::vector<std::thread> threads;
+    for (int s = 0; s < kSenders; ++s) {
+        threads.emplace_back([&, s] {
+            for (int i = 0; i < kPerSender; ++i) {
+                ASSERT_TRUE(channel.send(s * kPerSender + i));
+            }
+        });
+    }
+    std::atomic<int> received{0};
+    for (int r = 0; r < 2; ++r) {
+        threads.emplace_back([&] {
+            int value = 0;
+            while (channel.receive(value)) {
+                ++seen[value];
+                if (++received == kSenders * kPerSender) {
+                    channel.close();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& count : seen) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Capacities, ChannelStressTest, ::testing::Values(0, 1, 64));
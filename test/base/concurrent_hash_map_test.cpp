@@ -0,0 +1,233 @@
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "concurrent_hash_map.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+// Sends every key to the same segment and the same probe sequence.
+struct CollidingHash {
+    size_t operator()(int) const { return 42; }
+};
+}  // namespace
+
+TEST(ConcurrentHashMapTest, InsertFindAndErase) {
+    EpochDomain domain;
+    ConcurrentHashMap<std::string, int> map(0, 4, domain);
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.insert("one", 1));
+    EXPECT_FALSE(map.insert("one", 2));
+    int value = 0;
+    ASSERT_TRUE(map.find("one", value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(map.insert_or_assign("one", 3));
+    ASSERT_TRUE(map.find("one", value));
+    EXPECT_EQ(value, 3);
+    EXPECT_TRUE(map.insert_or_assign("two", 2));
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.contains("two"));
+    EXPECT_TRUE(map.erase("two"));
+    EXPECT_FALSE(map.erase("two"));
+    EXPECT_FALSE(map.contains("two"));
+    EXPECT_FALSE(map.find("two", value));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(ConcurrentHashMapTest, FindWithReadsInPlace) {
+    EpochDomain domain;
+    ConcurrentHashMap<int, std::vector<int>> map(0, 1, domain);
+    map.insert(1, std::vector<int>(1000, 7));
+    size_t length = 0;
+    EXPECT_TRUE(map.find_with(1, [&](const std::vector<int>& found) { length = found.size(); }));
+    EXPECT_EQ(length, 1000u);
+    EXPECT_FALSE(map.find_with(2, [&](const std::vector<int>&) { length = 0; }));
+    EXPECT_EQ(length, 1000u);
+}
+
+TEST(ConcurrentHashMapTest, GrowsFromNothing) {
+    EpochDomain domain;
+    ConcurrentHashMap<int, int> map(0, 3, domain);
+    EXPECT_EQ(map.segments(), 4u);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(map.insert(i, i * 2));
+    }
+    EXPECT_EQ(map.size(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        int value = -1;
+        ASSERT_TRUE(map.find(i, value)) << i;
+        ASSERT_EQ(value, i * 2);
+    }
+    EXPECT_FALSE(map.contains(10000));
+}
+
+TEST(ConcurrentHashMapTest, EveryKeyStaysReachableWhileASegmentGrows) {
+    EpochDomain domain;
+    ConcurrentHashMap<int, int> map(0, 1, domain);
+    for (int i = 0; i < 3000; ++i) {
+        ASSERT_TRUE(map.insert(i, i));
+        // Some of these are still in the old table, some already moved.
+        for (int j = 0; j <= i; ++j) {
+            ASSERT_TRUE(map.contains(j)) << j << " after inserting " << i;
+        }
+    }
+}
+
+TEST(ConcurrentHashMapTest, WritesReachKeysNotMovedYet) {
+    EpochDomain domain;
+    ConcurrentHashMap<int, int> map(0, 1, domain);
+    std::map<int, int> model;
+    for (int i = 0; i < 20000; ++i) {
+        ASSERT_EQ(map.insert(i, i), model.emplace(i, i).second);
+        // Older keys, likely left behind in the old table while a resize is in progress.
+        int assigned = i / 2;
+        ASSERT_EQ(map.insert_or_assign(assigned, -i), !model.count(assigned));
+        model[assigned] = -i;
+        if (i % 3 == 0) {
+            int erased = i / 3;
+            ASSERT_EQ(map.erase(erased), model.erase(erased) == 1);
+        }
+    }
+    EXPECT_EQ(map.size(), model.size());
+    for (int i = 0; i < 20000; ++i) {
+        int value = 0;
+        auto it = model.find(i);
+        ASSERT_EQ(map.find(i, value), it != model.end()) << i;
+        if (it != model.end()) {
+            ASSERT_EQ(value, it->second) << i;
+        }
+    }
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(19999));
+}
+
+TEST(ConcurrentHashMapTest, CollidingKeysProbeAndReuseDeletedSlots) {
+    EpochDomain domain;
+    ConcurrentHashMap<int, int, CollidingHash> map(0, 8, domain);
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            ASSERT_TRUE(map.insert(i, round));
+        }
+        for (int i = 0; i < 50; ++i) {
+            int value = -1;
+            ASSERT_TRUE(map.find(i, value));
+            ASSERT_EQ(value, round);
+        }
+        for (int i = 0; i < 50; i += 2) {
+            ASSERT_TRUE(map.erase(i));
+        }
+        for (int i = 1; i < 50; i += 2) {
+            ASSERT_TRUE(map.contains(i));
+            ASSERT_TRUE(map.erase(i));
+        }
+        EXPECT_TRUE(map.empty());
+    }
+}
+
+TEST(ConcurrentHashMapTest, ClearEmptiesEverySegment) {
+    EpochDomain domain;
+    ConcurrentHashMap<int, int> map(100, 4, domain);
+    for (int i = 0; i < 100; ++i) {
+        map.insert(i, i);
+    }
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(5));
+    EXPECT_TRUE(map.insert(5, 6));
+    int value = 0;
+    ASSERT_TRUE(map.find(5, value));
+    EXPECT_EQ(value, 6);
+}
+
+TEST(ConcurrentHashMapTest, ReadersSeeConsistentValuesWhileWritersResize) {
+    constexpr int kWriters = 3;
+    constexpr int kKeys = 4000;
+    EpochDomain domain(32);
+    ConcurrentHashMap<int, std::pair<int, int>> map(0, 4, domain);
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&, r] {
+            uint64_t seed = 12345 + r;
+            while (!done) {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                int key = static_cast<int>((seed >> 33) % (kWriters * kKeys));
+                std::pair<int, int> value;
+                if (map.find(key, value) && value.first != key) {
+                    ++torn;
+                }
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&, w] {
+            for (int round = 0; round < 3; ++round) {
+                for (int key = w * kKeys; key < (w + 1) * kKeys; ++key) {
+                    map.insert_or_assign(key, {key, round});
+                }
+                for (int key = w * kKeys; key < (w + 1) * kKeys; key += 3) {
+                    ASSERT_TRUE(map.erase(key));
+                }
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(map.size(), static_cast<size_t>(kWriters * (kKeys - (kKeys + 2) / 3)));
+    for (int key = 0; key < kWriters * kKeys; ++key) {
+        std::pair<int, int> value;
+        ASSERT_EQ(map.find(key, value), key % kKeys % 3 != 0) << key;
+        if (key % kKeys % 3) {
+            EXPECT_EQ(value, std::make_pair(key, 2));
+        }
+    }
+}
+
+TEST(ConcurrentHashMapTest, ReadersNeverMissAKeyWhileItMoves) {
+    constexpr int kPinned = 64;
+    EpochDomain domain(32);
+    ConcurrentHashMap<int, int> map(0, 1, domain);
+    for (int i = 0; i < kPinned; ++i) {
+        map.insert(i, i);
+    }
+    std::atomic<bool> done{false};
+    std::atomic<int> missed{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            while (!done) {
+                for (int i = 0; i < kPinned; ++i) {
+                    int value = -1;
+                    if (!map.find(i, value) || value != i) {
+                        ++missed;
+                    }
+                }
+            }
+        });
+    }
+    // Grows the segment many times, moving the pinned keys under the readers each time.
+    for (int i = kPinned; i < 50000; ++i) {
+        map.insert(i, i);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(missed.load(), 0);
+}
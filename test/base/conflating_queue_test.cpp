@@ -0,0 +1,122 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "conflating_queue.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(ConflatingQueueTest, LatestValueWinsAndKeepsItsPlace) {
+    ConflatingQueue<std::string, int> queue;
+    queue.push("a", 1);
+    queue.push("b", 2);
+    queue.push("a", 3);
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.conflated(), 1u);
+    std::string key;
+    int value = 0;
+    ASSERT_TRUE(queue.pop(key, value));
+    EXPECT_EQ(key, "a");
+    EXPECT_EQ(value, 3);
+    ASSERT_TRUE(queue.try_pop(key, value));
+    EXPECT_EQ(key, "b");
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(queue.try_pop(key, value));
+    // Once popped, the same key queues up anew.
+    queue.push("a", 4);
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(ConflatingQueueTest, NonBlockingModeDropsTheOldestKey) {
+    ConflatingQueue<int, int> queue(2, false);
+    queue.push(1, 1);
+    queue.push(2, 2);
+    EXPECT_TRUE(queue.full());
+    EXPECT_TRUE(queue.push(3, 3));
+    int key = 0;
+    int value = 0;
+    queue.pop(key, value);
+    EXPECT_EQ(key, 2);
+}
+
+TEST(ConflatingQueueTest, FullBlockingQueueStillTakesOverwrites) {
+    ConflatingQueue<int, int> queue(1, true);
+    queue.push(1, 1);
+    EXPECT_TRUE(queue.try_push(1, 2));
+    EXPECT_FALSE(queue.try_push(2, 1));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.push(2, 1, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(ConflatingQueueTest, BlockedPushBecomesAnOverwrite) {
+    ConflatingQueue<int, int> queue(1, true);
+    queue.push(1, 1);
+    std::thread producer([&] { EXPECT_TRUE(queue.push(2, 5)); });
+    std::this_thread::sleep_for(10ms);
+    int key = 0;
+    int value = 0;
+    ASSERT_TRUE(queue.pop(key, value));
+    producer.join();
+    ASSERT_TRUE(queue.pop(key, value, 100000));
+    EXPECT_EQ(key, 2);
+    EXPECT_EQ(value, 5);
+}
+
+TEST(ConflatingQueueTest, PopTimesOutAndCloseWakes) {
+    ConflatingQueue<int, int> queue;
+    int key = 0;
+    int value = 0;
+    EXPECT_FALSE(queue.pop(key, value, 10000));
+    std::thread consumer([&] {
+        int k = 0;
+        int v = 0;
+        EXPECT_FALSE(queue.pop(k, v));
+    });
+    std::this_thread::sleep_for(10ms);
+    queue.close();
+    consumer.join();
+    EXPECT_TRUE(queue.closed());
+    EXPECT_FALSE(queue.push(1, 1));
+}
+
+TEST(ConflatingQueueTest, ConsumerAlwaysSeesMonotonicValuesPerKey) {
+    constexpr int kKeys = 8;
+    constexpr int kUpdates = 20000;
+    ConflatingQueue<int, int, std::hash<int>, FutexLockPolicy> queue(kKeys, true);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 1; i <= kUpdates; ++i) {
+                // Producer p owns the keys of its parity, so per key the values only grow.
+                ASSERT_TRUE(queue.push((i % (kKeys / 2)) * 2 + p, i));
+            }
+        });
+    }
+    std::vector<int> last(kKeys, 0);
+    std::atomic<bool> done{false};
+    std::thread consumer([&] {
+        int key = 0;
+        int value = 0;
+        while (!done || !queue.empty()) {
+            if (queue.pop(key, value, 1000)) {
+                ASSERT_GT(value, last[key]);
+                last[key] = value;
+            }
+        }
+    });
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    done = true;
+    consumer.join();
+    // The final update of every key survives conflation.
+    for (int key = 0; key < kKeys; ++key) {
+        EXPECT_GT(last[key], kUpdates - kKeys);
+    }
+}
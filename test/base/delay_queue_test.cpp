@@ -0,0 +1,143 @@
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "delay_queue.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(DelayQueueTest, TimedOutConsumerHandsOverToAnotherSleeper) {
+    DelayQueue<int> queue;
+    std::atomic<bool> received{false};
+    std::thread blocked([&] {
+        int value = 0;
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, 1);
+        received = true;
+    });
+    std::this_thread::sleep_for(5ms);
+    int value = 0;
+    EXPECT_FALSE(queue.pop(value, 30000));
+    queue.push_after(1, 50ms);
+    auto start = std::chrono::steady_clock::now();
+    while (!received && std::chrono::steady_clock::now() - start < 2s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_TRUE(received.load());
+    queue.close();
+    blocked.join();
+}
+
+TEST(DelayQueueTest, ElementScheduledPastAnEarlierSleeperStillGetsPopped) {
+    DelayQueue<int> queue;
+    std::atomic<bool> received{false};
+    std::thread blocked([&] {
+        int value = 0;
+        EXPECT_TRUE(queue.pop(value));
+        received = true;
+    });
+    std::thread timed([&] {
+        int value = 0;
+        EXPECT_FALSE(queue.pop(value, 30000));
+    });
+    std::this_thread::sleep_for(10ms);
+    // Due after the timed consumer's wakeup, so push() leaves the waking to it.
+    queue.push_after(1, 50ms);
+    timed.join();
+    auto start = std::chrono::steady_clock::now();
+    while (!received && std::chrono::steady_clock::now() - start < 2s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_TRUE(received.load());
+    queue.close();
+    blocked.join();
+}
+
+TEST(DelayQueueTest, PopsInDeadlineOrderNotBefore) {
+    DelayQueue<int> queue;
+    auto start = std::chrono::steady_clock::now();
+    queue.push(2, start + 20ms);
+    queue.push(1, start + 10ms);
+    EXPECT_EQ(queue.size(), 2u);
+    int value = 0;
+    EXPECT_FALSE(queue.try_pop(value));
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 10ms);
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(DelayQueueTest, CancelAndTimeout) {
+    DelayQueue<int> queue;
+    TimerId id = queue.push_after(1, 5ms);
+    EXPECT_TRUE(queue.cancel(id));
+    EXPECT_FALSE(queue.cancel(id));
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop(value, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(DelayQueueTest, EarlierPushWakesASleepingConsumer) {
+    DelayQueue<int> queue;
+    queue.push_after(1, 10s);
+    std::thread consumer([&] {
+        int value = 0;
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, 2);
+    });
+    std::this_thread::sleep_for(10ms);
+    auto start = std::chrono::steady_clock::now();
+    queue.push_after(2, 5ms);
+    consumer.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+}
+
+TEST(DelayQueueTest, CloseWakesConsumersAndRejectsPushes) {
+    DelayQueue<int> queue;
+    std::thread consumer([&] {
+        int value = 0;
+        EXPECT_FALSE(queue.pop(value));
+    });
+    std::this_thread::sleep_for(10ms);
+    queue.close();
+    consumer.join();
+    TimerId id = queue.push_after(1, 1ms);
+    EXPECT_EQ(id.generation, 0u);
+}
+
+TEST(DelayQueueTest, ManyConsumersDrainEveryElement) {
+    constexpr int kItems = 2000;
+    DelayQueue<int, FutexLockPolicy> queue;
+    std::atomic<int> popped{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 4; ++c) {
+        consumers.emplace_back([&, c] {
+            int value = 0;
+            // Half of the consumers use short timeouts and keep coming back, the rest block.
+            while (popped < kItems) {
+                if (queue.pop(value, c % 2 ? 3000 : 0)) {
+                    if (++popped == kItems) {
+                        queue.close();
+                    }
+                }
+            }
+        });
+    }
+    std::mt19937 random(7);
+    for (int i = 0; i < kItems; ++i) {
+        queue.push_after(i, std::chrono::microseconds(random() % 20000));
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(popped.load(), kItems);
+}
@@ -0,0 +1,149 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "epoch.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+std::atomic<int> g_deleted{0};
+
+struct Tracked {
+    ~Tracked() { ++g_deleted; }
+};
+
+// Stays allocated when reclaimed, so readers can check they never saw a reclaimed version.
+struct Version {
+    explicit Version(uint64_t value) : value(value), reclaimed(false) {}
+
+    uint64_t value;
+    std::atomic<bool> reclaimed;
+};
+
+std::mutex g_graveyard_mutex;
+std::vector<Version*> g_graveyard;
+
+void bury(void* pointer) {
+    auto* version = static_cast<Version*>(pointer);
+    version->reclaimed.store(true, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(g_graveyard_mutex);
+    g_graveyard.push_back(version);
+}
+}  // namespace
+
+TEST(EpochTest, GuardsNest) {
+    EpochDomain domain;
+    EXPECT_FALSE(domain.in_critical_section());
+    {
+        EpochGuard outer(domain);
+        {
+            EpochGuard inner(domain);
+            EXPECT_TRUE(domain.in_critical_section());
+        }
+        EXPECT_TRUE(domain.in_critical_section());
+    }
+    EXPECT_FALSE(domain.in_critical_section());
+}
+
+TEST(EpochTest, AnOpenCriticalSectionHoldsBackReclamation) {
+    g_deleted = 0;
+    EpochDomain domain(1000);
+    std::atomic<bool> entered{false};
+    std::atomic<bool> leave{false};
+    std::thread reader([&] {
+        EpochGuard guard(domain);
+        entered = true;
+        while (!leave) {
+            std::this_thread::yield();
+        }
+    });
+    while (!entered) {
+        std::this_thread::yield();
+    }
+    domain.retire(new Tracked);
+    uint64_t epoch = domain.epoch();
+    for (int i = 0; i < 4; ++i) {
+        domain.collect();
+    }
+    // The reader may let the epoch move once, from the one it entered in, but never twice.
+    EXPECT_LE(domain.epoch(), epoch + 1);
+    EXPECT_EQ(g_deleted.load(), 0);
+    leave = true;
+    reader.join();
+    domain.synchronize();
+    EXPECT_EQ(g_deleted.load(), 1);
+}
+
+TEST(EpochTest, RetireCollectsEveryThreshold) {
+    g_deleted = 0;
+    EpochDomain domain(4);
+    for (int i = 0; i < 40; ++i) {
+        domain.retire(new Tracked);
+    }
+    // Nobody is inside a critical section, so everything but the last few epochs' worth is gone.
+    EXPECT_GE(g_deleted.load(), 28);
+    domain.synchronize();
+    EXPECT_EQ(g_deleted.load(), 40);
+}
+
+TEST(EpochTest, DestroyingTheDomainReclaimsTheRest) {
+    g_deleted = 0;
+    {
+        EpochDomain domain(1000);
+        domain.retire(new Tracked);
+        domain.retire(new Tracked);
+        EXPECT_EQ(g_deleted.load(), 0);
+    }
+    EXPECT_EQ(g_deleted.load(), 2);
+}
+
+TEST(EpochTest, ReadersNeverSeeAReclaimedVersion) {
+    EpochDomain domain(16);
+    std::atomic<Version*> current{new Version(0)};
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> stale{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            uint64_t last = 0;
+            while (!done) {
+                EpochGuard guard(domain);
+                Version* version = current.load(std::memory_order_acquire);
+                if (version->value < last) {
+                    ++stale;
+                }
+                last = version->value;
+                std::this_thread::yield();
+                if (version->reclaimed.load(std::memory_order_relaxed)) {
+                    ++stale;
+                }
+            }
+        });
+    }
+    for (uint64_t i = 1; i <= 20000; ++i) {
+        Version* old = current.exchange(new Version(i), std::memory_order_acq_rel);
+        domain.retire(old, &bury);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    domain.synchronize();
+    EXPECT_EQ(stale.load(), 0u);
+    {
+        std::lock_guard<std::mutex> lock(g_graveyard_mutex);
+        EXPECT_EQ(g_graveyard.size(), 20000u);
+        for (Version* version : g_graveyard) {
+            delete version;
+        }
+        g_graveyard.clear();
+    }
+    delete current.load();
+}
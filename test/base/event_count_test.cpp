@@ -0,0 +1,87 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "event_count.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(EventCountTest, NotifyBeforeWaitIsNotLost) {
+    EventCount event;
+    auto key = event.prepare_wait();
+    event.notify();
+    // The key is stale, so this returns immediately instead of sleeping.
+    event.wait(key);
+}
+
+TEST(EventCountTest, WaitUntilTimesOut) {
+    EventCount event;
+    auto key = event.prepare_wait();
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(event.wait_until(key, start + 20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(EventCountTest, NotifyAllWakesEveryWaiter) {
+    EventCount event;
+    std::atomic<bool> ready{false};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; ++i) {
+        waiters.emplace_back([&] {
+            while (!ready.load()) {
+                auto key = event.prepare_wait();
+                if (ready.load()) {
+                    event.cancel_wait();
+                    break;
+                }
+                event.wait(key);
+            }
+        });
+    }
+    std::this_thread::sleep_for(10ms);
+    ready = true;
+    event.notify_all();
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+}
+
+TEST(EventCountTest, HandoffsUnderContention) {
+    constexpr int kItems = 100000;
+    EventCount event;
+    std::atomic<int> available{0};
+    std::atomic<int> taken{0};
+    auto consume = [&] {
+        for (;;) {
+            int count = available.load();
+            if (count > 0 && available.compare_exchange_weak(count, count - 1)) {
+                if (++taken >= kItems) {
+                    event.notify_all();
+                }
+                continue;
+            }
+            if (taken.load() >= kItems) {
+                return;
+            }
+            auto key = event.prepare_wait();
+            if (available.load() > 0 || taken.load() >= kItems) {
+                event.cancel_wait();
+                continue;
+            }
+            event.wait(key);
+        }
+    };
+    std::thread first(consume);
+    std::thread second(consume);
+    for (int i = 0; i < kItems; ++i) {
+        ++available;
+        event.notify();
+    }
+    first.join();
+    second.join();
+    EXPECT_EQ(taken.load(), kItems);
+}
@@ -0,0 +1,138 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hazard_pointer.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+std::atomic<int> g_deleted{0};
+
+struct Tracked {
+    ~Tracked() { ++g_deleted; }
+};
+
+// Stays allocated when reclaimed, so readers can check they never saw a reclaimed version.
+struct Version {
+    explicit Version(uint64_t value) : value(value), reclaimed(false) {}
+
+    uint64_t value;
+    std::atomic<bool> reclaimed;
+};
+
+std::mutex g_graveyard_mutex;
+std::vector<Version*> g_graveyard;
+
+void bury(void* pointer) {
+    auto* version = static_cast<Version*>(pointer);
+    version->reclaimed.store(true, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(g_graveyard_mutex);
+    g_graveyard.push_back(version);
+}
+}  // namespace
+
+TEST(HazardPointerTest, ProtectedObjectsSurviveCollection) {
+    g_deleted = 0;
+    HazardPointerDomain domain(1000);
+    auto* kept = new Tracked;
+    std::atomic<Tracked*> source{kept};
+    HazardPointer hazard(domain);
+    EXPECT_EQ(hazard.protect(source), kept);
+    source.store(nullptr);
+    domain.retire(kept);
+    domain.retire(new Tracked);
+    domain.collect();
+    EXPECT_EQ(g_deleted.load(), 1);
+    hazard.reset();
+    domain.collect();
+    EXPECT_EQ(g_deleted.load(), 2);
+}
+
+TEST(HazardPointerTest, ProtectHandlesNull) {
+    HazardPointerDomain domain;
+    std::atomic<Tracked*> source{nullptr};
+    HazardPointer hazard(domain);
+    EXPECT_EQ(hazard.protect(source), nullptr);
+}
+
+TEST(HazardPointerTest, ResetProtectsAPointerDirectly) {
+    g_deleted = 0;
+    HazardPointerDomain domain(1000);
+    auto* object = new Tracked;
+    {
+        HazardPointer hazard(domain);
+        hazard.reset(object);
+        domain.retire(object);
+        domain.collect();
+        EXPECT_EQ(g_deleted.load(), 0);
+    }
+    // Destroying the hazard pointer gives up its protection.
+    domain.collect();
+    EXPECT_EQ(g_deleted.load(), 1);
+}
+
+TEST(HazardPointerTest, RetireScansPastTheThreshold) {
+    g_deleted = 0;
+    HazardPointerDomain domain(8);
+    for (int i = 0; i < 7; ++i) {
+        domain.retire(new Tracked);
+    }
+    EXPECT_EQ(g_deleted.load(), 0);
+    domain.retire(new Tracked);
+    EXPECT_EQ(g_deleted.load(), 8);
+}
+
+TEST(HazardPointerTest, DestroyingTheDomainReclaimsTheRest) {
+    g_deleted = 0;
+    {
+        HazardPointerDomain domain(1000);
+        domain.retire(new Tracked);
+        EXPECT_EQ(g_deleted.load(), 0);
+    }
+    EXPECT_EQ(g_deleted.load(), 1);
+}
+
+TEST(HazardPointerTest, ReadersNeverSeeAReclaimedVersion) {
+    HazardPointerDomain domain(16);
+    std::atomic<Version*> current{new Version(0)};
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> stale{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            HazardPointer hazard(domain);
+            while (!done) {
+                Version* version = hazard.protect(current);
+                std::this_thread::yield();
+                if (version->reclaimed.load(std::memory_order_relaxed)) {
+                    ++stale;
+                }
+                hazard.reset();
+            }
+        });
+    }
+    for (uint64_t i = 1; i <= 20000; ++i) {
+        Version* old = current.exchange(new Version(i), std::memory_order_acq_rel);
+        domain.retire(old, &bury);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    domain.collect();
+    EXPECT_EQ(stale.load(), 0u);
+    {
+        std::lock_guard<std::mutex> lock(g_graveyard_mutex);
+        EXPECT_EQ(g_graveyard.size(), 20000u);
+        for (Version* version : g_graveyard) {
+            delete version;
+        }
+        g_graveyard.clear();
+    }
+    delete current.load();
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "intrusive_mpsc_queue.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+struct Task : MpscNode {
+    explicit Task(int id = 0, int producer = 0) : id(id), producer(producer) {}
+
+    int id;
+    int producer;
+};
+}  // namespace
+
+TEST(IntrusiveMpscQueueTest, PopsInPushOrder) {
+    IntrusiveMpscQueue<Task> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.try_pop(), nullptr);
+    Task tasks[3] = {Task(0), Task(1), Task(2)};
+    for (Task& task : tasks) {
+        ASSERT_TRUE(queue.push(&task));
+    }
+    EXPECT_FALSE(queue.empty());
+    for (Task& task : tasks) {
+        EXPECT_EQ(queue.try_pop(), &task);
+    }
+    EXPECT_EQ(queue.try_pop(), nullptr);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(IntrusiveMpscQueueTest, ANodeCanBePushedAgainAfterItIsPopped) {
+    IntrusiveMpscQueue<Task> queue;
+    Task task(7);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(queue.push(&task));
+        EXPECT_EQ(queue.try_pop(), &task);
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(IntrusiveMpscQueueTest, PopWaitsAndTimesOut) {
+    IntrusiveMpscQueue<Task> queue;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.pop(20000), nullptr);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    Task task(1);
+    std::thread producer([&] {
+        std::this_thread::sleep_for(10ms);
+        queue.push(&task);
+    });
+    EXPECT_EQ(queue.pop(), &task);
+    producer.join();
+}
+
+TEST(IntrusiveMpscQueueTest, CloseRejectsPushesButDrains) {
+    IntrusiveMpscQueue<Task> queue;
+    Task first(1);
+    Task second(2);
+    ASSERT_TRUE(queue.push(&first));
+    queue.close();
+    EXPECT_TRUE(queue.closed());
+    EXPECT_FALSE(queue.push(&second));
+    EXPECT_EQ(queue.pop(), &first);
+    EXPECT_EQ(queue.pop(), nullptr);
+
+    IntrusiveMpscQueue<Task> idle;
+    std::thread closer([&] {
+        std::this_thread::sleep_for(10ms);
+        idle.close();
+    });
+    EXPECT_EQ(idle.pop(), nullptr);
+    closer.join();
+}
+
+TEST(IntrusiveMpscQueueTest, KeepsPerProducerOrderUnderContention) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 50000;
+    IntrusiveMpscQueue<Task> queue;
+    std::vector<std::unique_ptr<Task[]>> tasks;
+    for (int p = 0; p < kProducers; ++p) {
+        tasks.emplace_back(new Task[kPerProducer]);
+        for (int i = 0; i < kPerProducer; ++i) {
+            tasks[p][i].id = i;
+            tasks[p][i].producer = p;
+        }
+    }
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                ASSERT_TRUE(queue.push(&tasks[p][i]));
+                if (i % 1000 == 0) {
+                    std::this_thread::sleep_for(10us);
+                }
+            }
+        });
+    }
+    std::vector<int> next(kProducers, 0);
+    for (int popped = 0; popped < kProducers * kPerProducer; ++popped) {
+        Task* task = queue.pop();
+        ASSERT_NE(task, nullptr);
+        ASSERT_EQ(task->id, next[task->producer]++);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,102 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "memory_budget.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(MemoryBudgetTest, UnlimitedByDefault) {
+    MemoryBudget budget;
+    EXPECT_TRUE(budget.try_acquire(SIZE_MAX / 2));
+    EXPECT_EQ(budget.limit(), 0u);
+}
+
+TEST(MemoryBudgetTest, TryAcquireRespectsTheLimit) {
+    MemoryBudget budget(10);
+    EXPECT_TRUE(budget.try_acquire(6));
+    EXPECT_FALSE(budget.try_acquire(5));
+    EXPECT_TRUE(budget.try_acquire(4));
+    EXPECT_EQ(budget.used(), 10u);
+    budget.release(10);
+    // A request larger than the whole budget is granted once nothing else is held.
+    EXPECT_TRUE(budget.try_acquire(50));
+    EXPECT_FALSE(budget.try_acquire(1));
+}
+
+TEST(MemoryBudgetTest, FitsWithoutDiscountsTheCallersBytes) {
+    MemoryBudget budget(100);
+    budget.try_acquire(75);
+    budget.try_acquire(20);
+    EXPECT_FALSE(budget.fits_without(30, 20));
+    EXPECT_TRUE(budget.fits_without(25, 20));
+    EXPECT_TRUE(budget.fits_without(500, 95));
+}
+
+TEST(MemoryBudgetTest, AcquireTimesOutThenSucceedsAfterRelease) {
+    MemoryBudget budget(10);
+    budget.try_acquire(10);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(budget.acquire(1, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+    std::thread waiter([&] { EXPECT_TRUE(budget.acquire(5)); });
+    std::this_thread::sleep_for(10ms);
+    budget.release(6);
+    waiter.join();
+    EXPECT_EQ(budget.used(), 9u);
+}
+
+TEST(MemoryBudgetTest, RaisingTheLimitWakesWaiters) {
+    MemoryBudget budget(4);
+    budget.try_acquire(4);
+    std::thread waiter([&] { EXPECT_TRUE(budget.acquire(4)); });
+    std::this_thread::sleep_for(10ms);
+    budget.set_limit(8);
+    waiter.join();
+}
+
+TEST(MemoryBudgetTest, NeverOverdrawnUnderContention) {
+    MemoryBudget budget(16);
+    std::atomic<bool> overdrawn{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 20000; ++i) {
+                size_t bytes = 1 + (i + t) % 8;
+                ASSERT_TRUE(budget.acquire(bytes));
+                if (budget.used() > 16) {
+                    overdrawn = true;
+                }
+                budget.release(bytes);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(overdrawn.load());
+    EXPECT_EQ(budget.used(), 0u);
+}
+
+TEST(MemoryBudgetTest, ReleaseNeverMissesAWaiter) {
+    // A budget of one byte makes almost every acquire park; a lost wakeup shows up as a timeout.
+    MemoryBudget budget(1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 20000; ++i) {
+                ASSERT_TRUE(budget.acquire(1, 5000000));
+                budget.release(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(budget.used(), 0u);
+}
@@ -0,0 +1,145 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "multicast_ring.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(MulticastRingTest, RoundsCapacityUpToAPowerOfTwo) {
+    EXPECT_EQ(MulticastRing<int>(5).capacity(), 8u);
+    EXPECT_EQ(MulticastRing<int>(8).capacity(), 8u);
+    EXPECT_EQ(MulticastRing<int>(0).capacity(), 1u);
+}
+
+TEST(MulticastRingTest, EveryConsumerSeesEveryEvent) {
+    MulticastRing<int> ring(8);
+    auto& first = ring.add_consumer();
+    auto& second = ring.add_consumer();
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(ring.publish(i));
+    }
+    EXPECT_TRUE(ring.publish_with([](int& slot) { slot = 3; }));
+    EXPECT_EQ(ring.cursor(), 4u);
+    for (auto* consumer : {&first, &second}) {
+        std::vector<int> seen;
+        EXPECT_EQ(consumer->consume([&](const int& event, uint64_t sequence) {
+            EXPECT_EQ(static_cast<uint64_t>(event), sequence);
+            seen.push_back(event);
+        }),
+                  4u);
+        EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 3}));
+        EXPECT_EQ(consumer->next(), 4u);
+    }
+}
+
+TEST(MulticastRingTest, ADependentWaitsForItsDependencies) {
+    MulticastRing<int> ring(8);
+    auto& journal = ring.add_consumer();
+    auto& apply = ring.add_consumer({&journal});
+    ASSERT_TRUE(ring.publish(7));
+    ASSERT_TRUE(ring.publish(8));
+    EXPECT_EQ(apply.wait(10000), 0u);
+    ASSERT_EQ(journal.wait(), 2u);
+    EXPECT_EQ(journal[journal.next()], 7);
+    journal.release(1);
+    ASSERT_EQ(apply.wait(), 1u);
+    EXPECT_EQ(apply[0], 7);
+    apply.release(1);
+    journal.release(1);
+    ASSERT_EQ(apply.wait(), 1u);
+    EXPECT_EQ(apply[1], 8);
+}
+
+TEST(MulticastRingTest, TheSlowestConsumerHoldsBackTheWriter) {
+    MulticastRing<int> ring(2);
+    auto& fast = ring.add_consumer();
+    auto& slow = ring.add_consumer();
+    ASSERT_TRUE(ring.publish(0));
+    ASSERT_TRUE(ring.publish(1));
+    fast.release(fast.wait());
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring.publish(2, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    std::thread reader([&] {
+        std::this_thread::sleep_for(10ms);
+        slow.release(1);
+    });
+    EXPECT_TRUE(ring.publish(2));
+    reader.join();
+    EXPECT_EQ(ring.cursor(), 3u);
+}
+
+TEST(MulticastRingTest, CloseDeliversWhatWasPublished) {
+    MulticastRing<int> ring(4);
+    auto& consumer = ring.add_consumer();
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(consumer.wait(20000), 0u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    ASSERT_TRUE(ring.publish(1));
+    ring.close();
+    EXPECT_FALSE(ring.publish(2));
+    ASSERT_EQ(consumer.wait(), 1u);
+    consumer.release(1);
+    EXPECT_EQ(consumer.wait(), 0u);
+
+    MulticastRing<int> idle(4);
+    auto& waiter = idle.add_consumer();
+    std::thread closer([&] {
+        std::this_thread::sleep_for(10ms);
+        idle.close();
+    });
+    EXPECT_EQ(waiter.wait(), 0u);
+    closer.join();
+}
+
+TEST(MulticastRingTest, DiamondSeesEventsInOrderAfterBothBranches) {
+    constexpr uint64_t kEvents = 100000;
+    MulticastRing<uint64_t> ring(64);
+    auto& left = ring.add_consumer();
+    auto& right = ring.add_consumer();
+    auto& join = ring.add_consumer({&left, &right});
+    auto branch = [&](MulticastRing<uint64_t>::Consumer& consumer, uint64_t& sum) {
+        return std::thread([&] {
+            uint64_t expected = 0;
+            while (consumer.consume([&](const uint64_t& event, uint64_t sequence) {
+                EXPECT_EQ(event, sequence * 2);
+                EXPECT_EQ(sequence, expected++);
+                sum += event;
+            })) {
+            }
+        });
+    };
+    uint64_t left_sum = 0;
+    uint64_t right_sum = 0;
+    std::thread left_thread = branch(left, left_sum);
+    std::thread right_thread = branch(right, right_sum);
+    std::atomic<bool> ahead{false};
+    uint64_t joined = 0;
+    std::thread join_thread([&] {
+        while (size_t count = join.wait()) {
+            uint64_t next = join.next();
+            if (left.next() < next + count || right.next() < next + count) {
+                ahead = true;
+            }
+            joined += count;
+            join.release(count);
+        }
+    });
+    for (uint64_t i = 0; i < kEvents; ++i) {
+        ASSERT_TRUE(ring.publish(i * 2));
+    }
+    ring.close();
+    left_thread.join();
+    right_thread.join();
+    join_thread.join();
+    EXPECT_FALSE(ahead.load());
+    EXPECT_EQ(joined, kEvents);
+    EXPECT_EQ(left_sum, kEvents * (kEvents - 1));
+    EXPECT_EQ(right_sum, left_sum);
+}
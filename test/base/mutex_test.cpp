@@ -0,0 +1,88 @@
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "mutex.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(MutexTest, TryLockFailsWhileHeld) {
+    Mutex mutex;
+    ASSERT_TRUE(mutex.try_lock());
+    std::thread other([&] { EXPECT_FALSE(mutex.try_lock()); });
+    other.join();
+    mutex.unlock();
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(MutexTest, ContendedIncrementsAreExclusive) {
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 100000;
+    Mutex mutex;
+    long counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kIterations; ++i) {
+                std::lock_guard<Mutex> lock(mutex);
+                ++counter;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter, static_cast<long>(kThreads) * kIterations);
+}
+
+TEST(ConditionVariableTest, WaitForTimesOut) {
+    Mutex mutex;
+    ConditionVariable condition;
+    std::unique_lock<Mutex> lock(mutex);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(condition.wait_for(lock, 20ms, [] { return false; }));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+    EXPECT_TRUE(lock.owns_lock());
+}
+
+TEST(ConditionVariableTest, NotifyWakesAWaiter) {
+    Mutex mutex;
+    ConditionVariable condition;
+    bool ready = false;
+    std::thread waiter([&] {
+        std::unique_lock<Mutex> lock(mutex);
+        condition.wait(lock, [&] { return ready; });
+    });
+    std::this_thread::sleep_for(10ms);
+    {
+        std::lock_guard<Mutex> lock(mutex);
+        ready = true;
+    }
+    condition.notify_one();
+    waiter.join();
+}
+
+TEST(ConditionVariableTest, PingPongNeverLosesAWakeup) {
+    constexpr int kRounds = 20000;
+    Mutex mutex;
+    ConditionVariable condition;
+    int turn = 0;
+    auto player = [&](int parity) {
+        for (int i = 0; i < kRounds; ++i) {
+            std::unique_lock<Mutex> lock(mutex);
+            condition.wait(lock, [&] { return turn % 2 == parity; });
+            ++turn;
+            condition.notify_all();
+        }
+    };
+    std::thread even(player, 0);
+    std::thread odd(player, 1);
+    even.join();
+    odd.join();
+    EXPECT_EQ(turn, 2 * kRounds);
+}
@@ -0,0 +1,196 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "partitioned_queue.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+struct IdentityHash {
+    size_t operator()(int key) const { return static_cast<size_t>(key); }
+};
+
+using Queue = PartitionedQueue<int, int, IdentityHash>;
+}  // namespace
+
+TEST(PartitionedQueueTest, KeysMapToLanes) {
+    Queue queue(4);
+    EXPECT_EQ(queue.lanes(), 4u);
+    EXPECT_EQ(queue.lane_of(1), 1u);
+    EXPECT_EQ(queue.lane_of(6), 2u);
+    EXPECT_EQ(Queue(0).lanes(), 1u);
+}
+
+TEST(PartitionedQueueTest, AHeldLaneIsSkippedUntilReleased) {
+    Queue queue(4);
+    ASSERT_TRUE(queue.push(1, 10));
+    ASSERT_TRUE(queue.push(1, 11));
+    ASSERT_TRUE(queue.push(2, 20));
+    int value = 0;
+    size_t lane = 0;
+    ASSERT_TRUE(queue.try_pop(value, lane));
+    EXPECT_EQ(value, 10);
+    EXPECT_EQ(lane, 1u);
+    ASSERT_TRUE(queue.try_pop(value, lane));
+    EXPECT_EQ(value, 20);
+    size_t other = 0;
+    EXPECT_FALSE(queue.try_pop(value, other));
+    EXPECT_TRUE(queue.release(1));
+    ASSERT_TRUE(queue.try_pop(value, other));
+    EXPECT_EQ(value, 11);
+    EXPECT_EQ(other, 1u);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(PartitionedQueueTest, ReleaseRejectsLanesThatAreNotHeld) {
+    Queue queue(2);
+    EXPECT_FALSE(queue.release(0));
+    EXPECT_FALSE(queue.release(7));
+    ASSERT_TRUE(queue.push(0, 1));
+    ASSERT_TRUE(queue.push(0, 2));
+    int value = 0;
+    size_t lane = 0;
+    ASSERT_TRUE(queue.try_pop(value, lane));
+    EXPECT_TRUE(queue.release(lane));
+    // A second release must not hand the lane out while its next element is held by another consumer.
+    ASSERT_TRUE(queue.try_pop(value, lane));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(queue.push(0, 3));
+    EXPECT_TRUE(queue.release(lane));
+    EXPECT_FALSE(queue.release(lane));
+    ASSERT_TRUE(queue.try_pop(value, lane));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(queue.try_pop(value, lane));
+}
+
+TEST(PartitionedQueueTest, ReadyLanesAreServedInTurn) {
+    Queue queue(3);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(queue.push(0, i));
+    }
+    ASSERT_TRUE(queue.push(1, 100));
+    ASSERT_TRUE(queue.push(2, 200));
+    int value = 0;
+    size_t lane = 0;
+    ASSERT_TRUE(queue.try_pop(value, lane));
+    EXPECT_EQ(value, 0);
+    queue.release(lane);
+    // Lane 0 became ready again behind lanes 1 and 2.
+    std::vector<int> order;
+    while (queue.try_pop(value, lane)) {
+        order.push_back(value);
+        queue.release(lane);
+    }
+    EXPECT_EQ(order, (std::vector<int>{100, 200, 1, 2}));
+}
+
+TEST(PartitionedQueueTest, AFullLaneDropsItsOldestOrBlocks) {
+    Queue dropping(2, 2);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(dropping.push(0, i));
+    }
+    ASSERT_TRUE(dropping.push(1, 9));
+    EXPECT_EQ(dropping.size(), 3u);
+    int value = 0;
+    size_t lane = 0;
+    ASSERT_TRUE(dropping.try_pop(value, lane));
+    EXPECT_EQ(value, 1);
+
+    Queue blocking(2, 1, true);
+    ASSERT_TRUE(blocking.push(0, 1));
+    EXPECT_FALSE(blocking.try_push(0, 2));
+    EXPECT_TRUE(blocking.try_push(1, 3));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(blocking.push(0, 2, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(10ms);
+        int popped = 0;
+        size_t held = 0;
+        blocking.try_pop(popped, held);
+    });
+    EXPECT_TRUE(blocking.push(0, 2));
+    consumer.join();
+}
+
+TEST(PartitionedQueueTest, PopTimesOutAndCloseWakesWaiters) {
+    Queue queue(2);
+    int value = 0;
+    size_t lane = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop(value, lane, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    std::thread closer([&] {
+        std::this_thread::sleep_for(10ms);
+        queue.close();
+    });
+    EXPECT_FALSE(queue.pop(value, lane));
+    closer.join();
+    EXPECT_TRUE(queue.closed());
+    EXPECT_FALSE(queue.push(0, 1));
+}
+
+TEST(PartitionedQueueTest, KeepsPerKeyOrderWithParallelConsumers) {
+    constexpr int kKeys = 16;
+    constexpr int kPerKey = 2000;
+    PartitionedQueue<int, std::pair<int, int>, IdentityHash> queue(8, 64, true);
+    std::mutex seen_mutex;
+    std::map<int, int> last;
+    std::atomic<int> popped{0};
+    std::atomic<int> overlaps{0};
+    std::vector<std::atomic<int>> busy(kKeys);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 4; ++c) {
+        consumers.emplace_back([&] {
+            std::pair<int, int> element;
+            size_t lane = 0;
+            while (queue.pop(element, lane)) {
+                if (busy[element.first].fetch_add(1)) {
+                    ++overlaps;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(seen_mutex);
+                    auto found = last.find(element.first);
+                    EXPECT_TRUE(found == last.end() ? element.second == 0 : element.second == found->second + 1);
+                    last[element.first] = element.second;
+                }
+                busy[element.first].fetch_sub(1);
+                EXPECT_TRUE(queue.release(lane));
+                ++popped;
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerKey; ++i) {
+                for (int key = p; key < kKeys; key += 2) {
+                    ASSERT_TRUE(queue.push(key, {key, i}));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    while (popped < kKeys * kPerKey) {
+        std::this_thread::sleep_for(1ms);
+    }
+    queue.close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(overlaps.load(), 0);
+    for (int key = 0; key < kKeys; ++key) {
+        EXPECT_EQ(last[key], kPerKey - 1);
+    }
+}
@@ -0,0 +1,133 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "priority_heap.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+struct Task {
+    int priority;
+    int id;
+};
+
+struct PriorityOfTask {
+    int operator()(const Task& task) const { return task.priority; }
+};
+
+// Counts move assignments of an element onto itself.
+int self_moves = 0;
+
+struct Tracked {
+    int value = 0;
+
+    Tracked() = default;
+    explicit Tracked(int v) : value(v) {}
+    Tracked(Tracked&& other) = default;
+    Tracked& operator=(Tracked&& other) {
+        if (this == &other) {
+            ++self_moves;
+        }
+        value = other.value;
+        return *this;
+    }
+
+    bool operator<(const Tracked& other) const { return value < other.value; }
+};
+}  // namespace
+
+TEST(BucketHeapTest, NegativePrioritiesGoToTheLowestLevel) {
+    BucketHeap<Task, 4, PriorityOfTask> heap;
+    heap.push(Task{-1, 0});
+    heap.push(Task{1, 1});
+    heap.push(Task{INT32_MIN, 2});
+    Task task{};
+    heap.take(task);
+    EXPECT_EQ(task.id, 1);
+    heap.take(task);
+    EXPECT_EQ(task.id, 0);
+    heap.take(task);
+    EXPECT_EQ(task.id, 2);
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(BucketHeapTest, FifoWithinALevelAndClampsHighLevels) {
+    BucketHeap<Task, 4, PriorityOfTask> heap;
+    heap.push(Task{2, 0});
+    heap.push(Task{9, 1});
+    heap.push(Task{2, 2});
+    EXPECT_EQ(heap.top().id, 1);
+    EXPECT_TRUE(heap.outranks_lowest(Task{3, 3}));
+    EXPECT_FALSE(heap.outranks_lowest(Task{2, 3}));
+    Task task{};
+    heap.take(task);
+    heap.take(task);
+    EXPECT_EQ(task.id, 0);
+    heap.take(task);
+    EXPECT_EQ(task.id, 2);
+}
+
+TEST(BucketHeapTest, DropLowestRemovesTheNewestOfTheLowestLevel) {
+    BucketHeap<Task, 4, PriorityOfTask> heap;
+    heap.push(Task{0, 0});
+    heap.push(Task{0, 1});
+    heap.push(Task{3, 2});
+    heap.drop_lowest();
+    EXPECT_EQ(heap.size(), 2u);
+    Task task{};
+    heap.take(task);
+    heap.take(task);
+    EXPECT_EQ(task.id, 0);
+}
+
+TEST(DaryHeapTest, PopsInDescendingOrder) {
+    DaryHeap<int> heap;
+    for (int value : {5, 1, 9, 3, 7, 2, 8, 6, 4, 0}) {
+        heap.push(value);
+    }
+    EXPECT_EQ(heap.size(), 10u);
+    for (int expected = 9; expected >= 0; --expected) {
+        int value = -1;
+        heap.take(value);
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(DaryHeapTest, NeverMovesAnElementOntoItself) {
+    self_moves = 0;
+    DaryHeap<Tracked> heap;
+    heap.push(Tracked(1));
+    Tracked taken;
+    heap.take(taken);
+    EXPECT_EQ(taken.value, 1);
+    EXPECT_TRUE(heap.empty());
+    heap.push(Tracked(2));
+    heap.push(Tracked(3));
+    heap.drop_lowest();
+    heap.take(taken);
+    EXPECT_EQ(taken.value, 3);
+    heap.push(Tracked(4));
+    heap.drop_lowest();
+    EXPECT_TRUE(heap.empty());
+    EXPECT_EQ(self_moves, 0);
+}
+
+TEST(DaryHeapTest, DropLowestKeepsTheHeapValid) {
+    DaryHeap<int, std::less<int>, 2> heap;
+    for (int value = 0; value < 32; ++value) {
+        heap.push((value * 7) % 32);
+    }
+    EXPECT_TRUE(heap.outranks_lowest(5));
+    heap.drop_lowest();
+    heap.drop_lowest();
+    int previous = INT32_MAX;
+    while (!heap.empty()) {
+        int value = -1;
+        heap.take(value);
+        EXPECT_LT(value, previous);
+        EXPECT_GE(value, 2);
+        previous = value;
+    }
+}
@@ -0,0 +1,151 @@
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "rcu_cell.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+std::atomic<int> g_alive{0};
+
+struct Config {
+    explicit Config(int version = 0) : version(version), checksum(version * 3) { ++g_alive; }
+
+    Config(const Config& other) : version(other.version), checksum(other.checksum) { ++g_alive; }
+
+    Config& operator=(const Config&) = default;
+
+    ~Config() { --g_alive; }
+
+    int version;
+    int checksum;
+};
+}  // namespace
+
+TEST(RcuCellTest, ReadsTheCurrentVersion) {
+    EpochDomain domain;
+    RcuCell<std::string> cell("first", domain);
+    EXPECT_EQ(*cell.read(), "first");
+    EXPECT_EQ(cell.read()->size(), 5u);
+    cell.store("second");
+    EXPECT_EQ(*cell.read(), "second");
+    EXPECT_EQ(cell.read_with([](const std::string& value) { return value.size(); }), 6u);
+}
+
+TEST(RcuCellTest, ReadWithCopiesReferencesOut) {
+    EpochDomain domain;
+    RcuCell<std::string> cell("kept", domain);
+    auto value = cell.read_with([](const std::string& current) -> const std::string& { return current; });
+    static_assert(std::is_same_v<decltype(value), std::string>);
+    cell.store("replaced");
+    domain.synchronize();
+    EXPECT_EQ(value, "kept");
+}
+
+TEST(RcuCellTest, ASnapshotKeepsItsVersion) {
+    EpochDomain domain;
+    RcuCell<std::string> cell("old", domain);
+    auto snapshot = cell.read();
+    const std::string* seen = snapshot.get();
+    cell.store("new");
+    EXPECT_EQ(*snapshot, "old");
+    EXPECT_EQ(snapshot.get(), seen);
+    EXPECT_EQ(*cell.read(), "new");
+}
+
+TEST(RcuCellTest, UpdateModifiesACopy) {
+    EpochDomain domain;
+    RcuCell<std::map<std::string, int>> routes({{"a", 1}}, domain);
+    auto before = routes.read();
+    routes.update([](std::map<std::string, int>& next) { next["b"] = 2; });
+    EXPECT_EQ(before->size(), 1u);
+    EXPECT_EQ(routes.read()->size(), 2u);
+    EXPECT_EQ(routes.read()->at("b"), 2);
+}
+
+TEST(RcuCellTest, ReplacedVersionsAreReclaimed) {
+    g_alive = 0;
+    {
+        EpochDomain domain(1);
+        RcuCell<Config> cell(Config(0), domain);
+        for (int i = 1; i <= 100; ++i) {
+            cell.store(Config(i));
+        }
+        domain.synchronize();
+        EXPECT_EQ(g_alive.load(), 1);
+    }
+    EXPECT_EQ(g_alive.load(), 0);
+}
+
+TEST(RcuCellTest, UpdatesReclaimWithTheDefaultThreshold) {
+    g_alive = 0;
+    {
+        EpochDomain domain;
+        RcuCell<Config> cell(Config(0), domain);
+        for (int i = 1; i <= 40; ++i) {
+            cell.store(Config(i));
+            EXPECT_EQ(g_alive.load(), 1);
+        }
+        {
+            // A held snapshot pins its version until a later update finds it released.
+            auto snapshot = cell.read();
+            for (int i = 41; i <= 50; ++i) {
+                cell.store(Config(i));
+            }
+            EXPECT_EQ(snapshot->version, 40);
+            EXPECT_GT(g_alive.load(), 1);
+        }
+        cell.store(Config(51));
+        EXPECT_EQ(g_alive.load(), 1);
+    }
+    EXPECT_EQ(g_alive.load(), 0);
+}
+
+TEST(RcuCellTest, ConcurrentUpdatesAreNotLostAndReadsAreConsistent) {
+    constexpr int kWriters = 3;
+    constexpr int kUpdates = 5000;
+    EpochDomain domain(32);
+    RcuCell<Config> cell(Config(0), domain);
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            int last = 0;
+            while (!done) {
+                auto snapshot = cell.read();
+                if (snapshot->checksum != snapshot->version * 3 || snapshot->version < last) {
+                    ++torn;
+                }
+                last = snapshot->version;
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < kUpdates; ++i) {
+                cell.update([](Config& next) {
+                    ++next.version;
+                    next.checksum = next.version * 3;
+                });
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(cell.read()->version, kWriters * kUpdates);
+}
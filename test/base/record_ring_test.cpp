@@ -0,0 +1,158 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "record_ring.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+bool write_record(RecordRing& ring, const std::string& text, const int64_t& timeout = -1) {
+    char* data = timeout < 0 ? ring.try_reserve(text.size()) : ring.reserve(text.size(), timeout);
+    if (!data) {
+        return false;
+    }
+    std::memcpy(data, text.data(), text.size());
+    ring.commit(text.size());
+    return true;
+}
+
+std::string read_record(RecordRing& ring) {
+    RecordRing::Record record;
+    if (!ring.try_read(record)) {
+        return "<none>";
+    }
+    std::string text(record.data, record.size);
+    ring.release();
+    return text;
+}
+}  // namespace
+
+TEST(RecordRingTest, RoundsCapacityUp) {
+    EXPECT_EQ(RecordRing(1).capacity(), 64u);
+    EXPECT_EQ(RecordRing(100).capacity(), 128u);
+    EXPECT_EQ(RecordRing(64).max_record_size(), 56u);
+}
+
+TEST(RecordRingTest, RecordsComeOutInOrderAndAligned) {
+    RecordRing ring(256);
+    EXPECT_TRUE(ring.empty());
+    ASSERT_TRUE(write_record(ring, "a"));
+    ASSERT_TRUE(write_record(ring, "hello"));
+    ASSERT_TRUE(write_record(ring, ""));
+    EXPECT_EQ(ring.used(), 16u + 16u + 8u);
+    RecordRing::Record record;
+    ASSERT_TRUE(ring.try_read(record));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(record.data) % 8, 0u);
+    EXPECT_EQ(std::string(record.data, record.size), "a");
+    // Reading again before release() shows the same record.
+    ASSERT_TRUE(ring.try_read(record));
+    EXPECT_EQ(std::string(record.data, record.size), "a");
+    ring.release();
+    EXPECT_EQ(read_record(ring), "hello");
+    EXPECT_EQ(read_record(ring), "");
+    EXPECT_EQ(read_record(ring), "<none>");
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RecordRingTest, CommitMayShrinkTheReservation) {
+    RecordRing ring(64);
+    char* data = ring.try_reserve(40);
+    ASSERT_NE(data, nullptr);
+    std::memcpy(data, "abc", 3);
+    ring.commit(3);
+    EXPECT_EQ(ring.used(), 16u);
+    EXPECT_EQ(read_record(ring), "abc");
+}
+
+TEST(RecordRingTest, TooLargeOrFullFails) {
+    RecordRing ring(64);
+    EXPECT_EQ(ring.try_reserve(57), nullptr);
+    EXPECT_EQ(ring.reserve(57), nullptr);
+    ASSERT_TRUE(write_record(ring, std::string(40, 'x')));
+    EXPECT_FALSE(write_record(ring, std::string(9, 'y')));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(write_record(ring, std::string(9, 'y'), 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    EXPECT_TRUE(write_record(ring, std::string(8, 'y')));
+}
+
+TEST(RecordRingTest, WrapsRecordsThatDoNotFitAtTheEnd) {
+    RecordRing ring(64);
+    ASSERT_TRUE(write_record(ring, std::string(24, 'a')));  // [0, 32)
+    ASSERT_TRUE(write_record(ring, std::string(8, 'b')));   // [32, 48)
+    EXPECT_EQ(read_record(ring), std::string(24, 'a'));
+    // 24 bytes need 32, only 16 are left at the end: a wrap marker skips them while 'b' is still unread.
+    ASSERT_TRUE(write_record(ring, std::string(24, 'c')));
+    EXPECT_EQ(ring.used(), 16u + 16u + 32u);
+    EXPECT_EQ(read_record(ring), std::string(8, 'b'));
+    EXPECT_EQ(read_record(ring), std::string(24, 'c'));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RecordRingTest, AnEmptyRingFitsTheLargestRecordAtAnyOffset) {
+    RecordRing ring(64);
+    ASSERT_TRUE(write_record(ring, std::string(8, 'a')));
+    EXPECT_EQ(read_record(ring), std::string(8, 'a'));
+    ASSERT_NE(ring.try_reserve(56), nullptr);
+    ring.commit(56);
+    EXPECT_EQ(ring.used(), 64u);
+    RecordRing::Record record;
+    ASSERT_TRUE(ring.try_read(record));
+    EXPECT_EQ(record.size, 56u);
+    ring.release();
+    for (size_t size : {8, 16, 24, 40, 56}) {
+        ASSERT_TRUE(write_record(ring, std::string(size, 'x'))) << size;
+        EXPECT_EQ(read_record(ring), std::string(size, 'x'));
+    }
+}
+
+TEST(RecordRingTest, ReadWaitsAndCloseDrains) {
+    RecordRing ring(64);
+    RecordRing::Record record;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring.read(record, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    ASSERT_TRUE(write_record(ring, "last"));
+    ring.close();
+    ASSERT_TRUE(ring.read(record));
+    ring.release();
+    EXPECT_FALSE(ring.read(record));
+    ASSERT_TRUE(write_record(ring, std::string(56, 'x')));
+    EXPECT_EQ(ring.reserve(8), nullptr);
+}
+
+TEST(RecordRingTest, StreamsVariableSizeRecordsBetweenThreads) {
+    constexpr uint32_t kRecords = 200000;
+    RecordRing ring(256);
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < kRecords; ++i) {
+            // Sizes from 4 to 248 bytes, including records that need the whole ring to themselves.
+            size_t size = 4 + (i * 37) % (ring.max_record_size() - 3);
+            char* data = ring.reserve(size);
+            ASSERT_NE(data, nullptr);
+            std::memcpy(data, &i, sizeof(i));
+            std::memset(data + sizeof(i), static_cast<int>(i & 0xff), size - sizeof(i));
+            ring.commit(size);
+        }
+    });
+    RecordRing::Record record;
+    for (uint32_t i = 0; i < kRecords; ++i) {
+        ASSERT_TRUE(ring.read(record));
+        ASSERT_EQ(record.size, 4 + (i * 37) % (ring.max_record_size() - 3));
+        uint32_t sequence = 0;
+        std::memcpy(&sequence, record.data, sizeof(sequence));
+        ASSERT_EQ(sequence, i);
+        if (record.size > sizeof(sequence)) {
+            ASSERT_EQ(static_cast<unsigned char>(record.data[record.size - 1]), i & 0xff);
+        }
+        ring.release();
+    }
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "reorder_buffer.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(ReorderBufferTest, PopsInSequenceOrder) {
+    ReorderBuffer<int> buffer(4);
+    EXPECT_EQ(buffer.next_ticket(), 0u);
+    EXPECT_EQ(buffer.next_ticket(), 1u);
+    EXPECT_TRUE(buffer.put(2, 20));
+    EXPECT_TRUE(buffer.put(1, 10));
+    int value = 0;
+    EXPECT_FALSE(buffer.try_pop(value));
+    EXPECT_EQ(buffer.size(), 2u);
+    EXPECT_TRUE(buffer.put(0, 0));
+    for (int expected : {0, 10, 20}) {
+        ASSERT_TRUE(buffer.try_pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_EQ(buffer.next_sequence(), 3u);
+    EXPECT_EQ(buffer.size(), 0u);
+}
+
+TEST(ReorderBufferTest, RejectsDuplicatesAndPoppedSequences) {
+    ReorderBuffer<int> buffer(4);
+    EXPECT_TRUE(buffer.put(1, 1));
+    EXPECT_FALSE(buffer.put(1, 2));
+    EXPECT_TRUE(buffer.put(0, 0));
+    int value = 0;
+    ASSERT_TRUE(buffer.try_pop(value));
+    EXPECT_FALSE(buffer.put(0, 5));
+    ASSERT_TRUE(buffer.try_pop(value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST(ReorderBufferTest, PutBeyondTheWindowWaits) {
+    ReorderBuffer<int> buffer(2);
+    EXPECT_EQ(buffer.window(), 2u);
+    EXPECT_EQ(ReorderBuffer<int>(0).window(), 1u);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(buffer.put(2, 2, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    std::thread ahead([&] { EXPECT_TRUE(buffer.put(3, 3)); });
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(buffer.size(), 0u);
+    int value = 0;
+    for (int sequence = 0; sequence < 3; ++sequence) {
+        ASSERT_TRUE(buffer.put(sequence, sequence));
+        ASSERT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, sequence);
+    }
+    ahead.join();
+    ASSERT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, 3);
+}
+
+TEST(ReorderBufferTest, PopTimesOutAndCloseWakesWaiters) {
+    ReorderBuffer<int> buffer(2);
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(buffer.pop(value, 20000));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    std::thread producer([&] { EXPECT_FALSE(buffer.put(5, 5)); });
+    std::thread closer([&] {
+        std::this_thread::sleep_for(10ms);
+        buffer.close();
+    });
+    EXPECT_FALSE(buffer.pop(value));
+    producer.join();
+    closer.join();
+    EXPECT_TRUE(buffer.closed());
+    EXPECT_FALSE(buffer.put(0, 0));
+}
+
+TEST(ReorderBufferTest, RestoresOrderAcrossWorkers) {
+    constexpr int kItems = 20000;
+    ReorderBuffer<uint64_t> buffer(16);
+    std::atomic<uint64_t> next{0};
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&] {
+            for (;;) {
+                uint64_t sequence = next.fetch_add(1);
+                if (sequence >= static_cast<uint64_t>(kItems)) {
+                    return;
+                }
+                if (sequence % 7 == 0) {
+                    std::this_thread::yield();
+                }
+                ASSERT_TRUE(buffer.put(sequence, sequence * 3));
+            }
+        });
+    }
+    uint64_t value = 0;
+    for (uint64_t expected = 0; expected < static_cast<uint64_t>(kItems); ++expected) {
+        ASSERT_TRUE(buffer.pop(value));
+        ASSERT_EQ(value, expected * 3);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(buffer.size(), 0u);
+}
@@ -0,0 +1,154 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "rw_lock.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+template <typename Lock>
+class RwLockTest : public ::testing::Test {
+protected:
+    Lock lock;
+};
+
+using RwLocks = ::testing::Types<RwSpinLock, DistributedRwLock>;
+TYPED_TEST_SUITE(RwLockTest, RwLocks);
+}  // namespace
+
+TYPED_TEST(RwLockTest, ReadersShareWritersExclude) {
+    auto& lock = this->lock;
+    ASSERT_TRUE(lock.try_lock_shared());
+    std::thread other([&] {
+        EXPECT_TRUE(lock.try_lock_shared());
+        lock.unlock_shared();
+        EXPECT_FALSE(lock.try_lock());
+    });
+    other.join();
+    lock.unlock_shared();
+    ASSERT_TRUE(lock.try_lock());
+    std::thread blocked([&] {
+        EXPECT_FALSE(lock.try_lock_shared());
+        EXPECT_FALSE(lock.try_lock());
+    });
+    blocked.join();
+    lock.unlock();
+    EXPECT_TRUE(lock.try_lock_shared());
+    lock.unlock_shared();
+}
+
+TYPED_TEST(RwLockTest, WorksWithStandardLockWrappers) {
+    auto& lock = this->lock;
+    {
+        std::shared_lock<TypeParam> first(lock);
+        std::shared_lock<TypeParam> second(lock, std::try_to_lock);
+        EXPECT_TRUE(second.owns_lock());
+    }
+    {
+        std::unique_lock<TypeParam> exclusive(lock);
+        EXPECT_TRUE(exclusive.owns_lock());
+    }
+    std::lock_guard<TypeParam> guard(lock);
+}
+
+TYPED_TEST(RwLockTest, AWriterWaitsForReadersToLeave) {
+    auto& lock = this->lock;
+    lock.lock_shared();
+    std::atomic<bool> written{false};
+    std::thread writer([&] {
+        lock.lock();
+        written = true;
+        lock.unlock();
+    });
+    std::this_thread::sleep_for(10ms);
+    EXPECT_FALSE(written.load());
+    lock.unlock_shared();
+    writer.join();
+    EXPECT_TRUE(written.load());
+}
+
+TYPED_TEST(RwLockTest, ReadersNeverSeeAHalfWrittenPair) {
+    auto& lock = this->lock;
+    uint64_t first = 0;
+    uint64_t second = 0;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done) {
+                std::shared_lock<TypeParam> guard(lock);
+                if (first != second) {
+                    ++torn;
+                }
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < 20000; ++i) {
+                std::lock_guard<TypeParam> guard(lock);
+                ++first;
+                ++second;
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(first, 40000u);
+}
+
+TEST(RwSpinLockTest, AWaitingWriterHoldsOffNewReaders) {
+    RwSpinLock lock;
+    lock.lock_shared();
+    std::thread writer([&] {
+        lock.lock();
+        lock.unlock();
+    });
+    // Once the writer is pending, new readers are turned away until it has had its turn.
+    bool turned_away = false;
+    for (int i = 0; i < 1000 && !turned_away; ++i) {
+        if (lock.try_lock_shared()) {
+            lock.unlock_shared();
+            std::this_thread::sleep_for(100us);
+        } else {
+            turned_away = true;
+        }
+    }
+    EXPECT_TRUE(turned_away);
+    lock.unlock_shared();
+    writer.join();
+    EXPECT_TRUE(lock.try_lock_shared());
+    lock.unlock_shared();
+}
+
+TEST(DistributedRwLockTest, RoundsSlotsUp) {
+    DistributedRwLock lock(3);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 6; ++r) {
+        readers.emplace_back([&] {
+            lock.lock_shared();
+            lock.unlock_shared();
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_TRUE(lock.try_lock());
+    lock.unlock();
+}
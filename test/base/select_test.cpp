@@ -0,0 +1,118 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "select.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(SelectTest, NoCasesReturnsAtOnce) {
+    Select select;
+    EXPECT_EQ(select.wait(), -1);
+    EXPECT_EQ(select.poll(), -1);
+}
+
+TEST(SelectTest, PollPicksTheReadyCase) {
+    BlockingQueue<int> first(4);
+    BlockingQueue<int> second(4);
+    int from_first = 0;
+    int from_second = 0;
+    Select select;
+    select.on_pop(first, from_first).on_pop(second, from_second);
+    EXPECT_EQ(select.poll(), -1);
+    second.push_back(7);
+    EXPECT_EQ(select.poll(), 1);
+    EXPECT_EQ(from_second, 7);
+}
+
+TEST(SelectTest, PushCaseWaitsForRoom) {
+    BlockingQueue<int> queue(1, true);
+    queue.push_back(0);
+    int element = 5;
+    Select select;
+    select.on_push(queue, element);
+    EXPECT_EQ(select.wait(10000), -1);
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(10ms);
+        int value = 0;
+        queue.pop_front(value);
+    });
+    EXPECT_EQ(select.wait(1000000), 0);
+    consumer.join();
+    EXPECT_EQ(queue.front(), 5);
+}
+
+TEST(SelectTest, WaitTimesOut) {
+    BlockingQueue<int> queue(4);
+    int element = 0;
+    Select select;
+    select.on_pop(queue, element);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(select.wait(20000), -1);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(SelectTest, ReturnsWhenEveryQueueIsClosed) {
+    BlockingQueue<int> first(4);
+    BlockingQueue<int> second(4);
+    int element = 0;
+    Select select;
+    select.on_pop(first, element).on_pop(second, element);
+    std::thread closer([&] {
+        std::this_thread::sleep_for(10ms);
+        first.close();
+        second.close();
+    });
+    EXPECT_EQ(select.wait(), -1);
+    closer.join();
+}
+
+TEST(SelectTest, IsFairAcrossReadyCases) {
+    BlockingQueue<int> first(8);
+    BlockingQueue<int> second(8);
+    for (int i = 0; i < 4; ++i) {
+        first.push_back(i);
+        second.push_back(i);
+    }
+    int element = 0;
+    Select select;
+    select.on_pop(first, element).on_pop(second, element);
+    int hits[2] = {0, 0};
+    for (int i = 0; i < 4; ++i) {
+        ++hits[select.poll()];
+    }
+    EXPECT_EQ(hits[0], 2);
+    EXPECT_EQ(hits[1], 2);
+}
+
+TEST(SelectTest, DrainsSeveralProducers) {
+    constexpr int kPerProducer = 10000;
+    BlockingQueue<int> first(16, true);
+    BlockingQueue<int> second(16, true);
+    std::vector<std::thread> producers;
+    producers.emplace_back([&] {
+        for (int i = 0; i < kPerProducer; ++i) {
+            first.push_back(1);
+        }
+    });
+    producers.emplace_back([&] {
+        for (int i = 0; i < kPerProducer; ++i) {
+            second.push_back(2);
+        }
+    });
+    int element = 0;
+    Select select;
+    select.on_pop(first, element).on_pop(second, element);
+    long sum = 0;
+    for (int i = 0; i < 2 * kPerProducer; ++i) {
+        ASSERT_GE(select.wait(1000000), 0);
+        sum += element;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(sum, 3L * kPerProducer);
+}
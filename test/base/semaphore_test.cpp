@@ -0,0 +1,64 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "semaphore.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+TEST(SemaphoreTest, CountsPermits) {
+    Semaphore semaphore(2);
+    EXPECT_EQ(semaphore.available(), 2u);
+    EXPECT_TRUE(semaphore.try_acquire());
+    EXPECT_TRUE(semaphore.try_acquire());
+    EXPECT_FALSE(semaphore.try_acquire());
+    semaphore.release(3);
+    EXPECT_EQ(semaphore.available(), 3u);
+}
+
+TEST(SemaphoreTest, TryAcquireForTimesOut) {
+    Semaphore semaphore;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(semaphore.try_acquire_for(20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(SemaphoreTest, ReleaseWakesASleeper) {
+    Semaphore semaphore;
+    std::thread waiter([&] { semaphore.acquire(); });
+    std::this_thread::sleep_for(10ms);
+    semaphore.release();
+    waiter.join();
+    EXPECT_EQ(semaphore.available(), 0u);
+}
+
+TEST(SemaphoreTest, BoundsConcurrency) {
+    constexpr int kThreads = 8;
+    constexpr int kPermits = 3;
+    Semaphore semaphore(kPermits);
+    std::atomic<int> inside{0};
+    std::atomic<int> peak{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                semaphore.acquire();
+                int now = ++inside;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+                }
+                --inside;
+                semaphore.release();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(peak.load(), kPermits);
+    EXPECT_EQ(semaphore.available(), static_cast<uint32_t>(kPermits));
+}
@@ -0,0 +1,75 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "seq_lock.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+struct Quote {
+    uint64_t bid;
+    uint64_t ask;
+    uint32_t size;
+    uint64_t sequence;
+};
+
+// Not a multiple of the word size.
+struct Odd {
+    char text[11];
+};
+}  // namespace
+
+TEST(SeqLockTest, LoadsWhatWasStored) {
+    SeqLock<Quote> quote(Quote{1, 2, 3, 4});
+    EXPECT_EQ(quote.version(), 0u);
+    Quote value = quote.load();
+    EXPECT_EQ(value.bid, 1u);
+    EXPECT_EQ(value.sequence, 4u);
+    quote.store(Quote{5, 6, 7, 8});
+    EXPECT_EQ(quote.version(), 1u);
+    ASSERT_TRUE(quote.try_load(value));
+    EXPECT_EQ(value.ask, 6u);
+    EXPECT_EQ(value.size, 7u);
+}
+
+TEST(SeqLockTest, HandlesSizesOffTheWordGrid) {
+    SeqLock<Odd> lock(Odd{"0123456789"});
+    EXPECT_STREQ(lock.load().text, "0123456789");
+    lock.store(Odd{"abcdefghij"});
+    EXPECT_STREQ(lock.load().text, "abcdefghij");
+}
+
+TEST(SeqLockTest, ReadersNeverSeeATornValue) {
+    constexpr uint64_t kStores = 200000;
+    SeqLock<Quote> quote(Quote{0, 0, 0, 0});
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            uint64_t last = 0;
+            while (!done) {
+                Quote value = quote.load();
+                if (value.ask != value.bid * 2 || value.size != static_cast<uint32_t>(value.bid) ||
+                    value.sequence != value.bid || value.bid < last) {
+                    ++torn;
+                }
+                last = value.bid;
+            }
+        });
+    }
+    for (uint64_t i = 1; i <= kStores; ++i) {
+        quote.store(Quote{i, i * 2, static_cast<uint32_t>(i), i});
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(quote.version(), kStores);
+    EXPECT_EQ(quote.load().bid, kStores);
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "timing_wheel.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+std::vector<int> advance(TimingWheel<int>& wheel, Clock::time_point now) {
+    std::vector<int> fired;
+    wheel.advance(now, [&](int&& value) { fired.push_back(value); });
+    return fired;
+}
+}  // namespace
+
+TEST(TimingWheelTest, FiresOnTheFirstTickAtOrAfterTheDeadline) {
+    Clock::time_point origin = Clock::now();
+    TimingWheel<int> wheel(milliseconds(10), origin);
+    wheel.schedule(1, origin + milliseconds(25));
+    EXPECT_TRUE(advance(wheel, origin + milliseconds(29)).empty());
+    EXPECT_EQ(advance(wheel, origin + milliseconds(30)), std::vector<int>{1});
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, PastDeadlinesFireOnTheNextAdvance) {
+    Clock::time_point origin = Clock::now();
+    TimingWheel<int> wheel(milliseconds(1), origin);
+    advance(wheel, origin + milliseconds(100));
+    wheel.schedule(2, origin + milliseconds(50));
+    Clock::time_point when;
+    ASSERT_TRUE(wheel.next_expiry(when));
+    EXPECT_LE(when, origin + milliseconds(100));
+    EXPECT_EQ(advance(wheel, origin + milliseconds(100)), std::vector<int>{2});
+}
+
+TEST(TimingWheelTest, CancelOnlyMatchesTheLiveTimer) {
+    Clock::time_point origin = Clock::now();
+    TimingWheel<int> wheel(milliseconds(1), origin);
+    TimerId first = wheel.schedule(1, origin + milliseconds(5));
+    EXPECT_TRUE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(first));
+    // The slab slot is reused, but the stale id must not cancel the new timer.
+    TimerId second = wheel.schedule(2, origin + milliseconds(5));
+    EXPECT_FALSE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(TimerId{}));
+    EXPECT_EQ(wheel.size(), 1u);
+    EXPECT_TRUE(wheel.cancel(second));
+    Clock::time_point when;
+    EXPECT_FALSE(wheel.next_expiry(when));
+}
+
+TEST(TimingWheelTest, NextExpiryNeverOvershoots) {
+    Clock::time_point origin = Clock::now();
+    TimingWheel<int> wheel(milliseconds(1), origin);
+    wheel.schedule(1, origin + milliseconds(5000));
+    Clock::time_point when;
+    ASSERT_TRUE(wheel.next_expiry(when));
+    EXPECT_LE(when, origin + milliseconds(5000));
+    EXPECT_GT(when, origin);
+}
+
+TEST(TimingWheelTest, CascadesAcrossLevelsInDeadlineOrder) {
+    Clock::time_point origin = Clock::now();
+    TimingWheel<int> wheel(milliseconds(1), origin);
+    std::mt19937 random(42);
+    std::vector<int> deadlines;
+    for (int i = 0; i < 5000; ++i) {
+        int deadline = static_cast<int>(random() % 300000);
+        deadlines.push_back(deadline);
+        wheel.schedule(deadline, origin + milliseconds(deadline));
+    }
+    std::vector<int> fired;
+    for (int now = 0; now < 300000 + 997; now += 997) {
+        for (int deadline : advance(wheel, origin + milliseconds(now))) {
+            ASSERT_LE(deadline, now);
+            ASSERT_GT(deadline, now - 997);
+            fired.push_back(deadline);
+        }
+    }
+    std::sort(deadlines.begin(), deadlines.end());
+    std::sort(fired.begin(), fired.end());
+    EXPECT_EQ(fired, deadlines);
+}
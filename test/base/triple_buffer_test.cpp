@@ -0,0 +1,84 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "triple_buffer.hpp"
+
+using namespace cybertron::base;
+
+namespace {
+struct Snapshot {
+    uint64_t values[32];
+};
+}  // namespace
+
+TEST(TripleBufferTest, StartsWithTheInitialValue) {
+    TripleBuffer<int> buffer(7);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.read_buffer(), 7);
+    EXPECT_EQ(buffer.write_buffer(), 7);
+}
+
+TEST(TripleBufferTest, ReaderPicksUpTheLatestPublish) {
+    TripleBuffer<int> buffer(0);
+    buffer.write(1);
+    buffer.write(2);
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.read_buffer(), 2);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.read_buffer(), 2);
+    buffer.write_buffer() = 3;
+    EXPECT_EQ(buffer.read(), 2);
+    buffer.publish();
+    EXPECT_EQ(buffer.read(), 3);
+}
+
+TEST(TripleBufferTest, WriterNeverTouchesTheReadBuffer) {
+    TripleBuffer<int> buffer(0);
+    buffer.write(1);
+    ASSERT_TRUE(buffer.update());
+    const int* reading = &buffer.read_buffer();
+    for (int i = 2; i < 10; ++i) {
+        EXPECT_NE(&buffer.write_buffer(), reading);
+        buffer.write(i);
+    }
+    EXPECT_EQ(*reading, 1);
+    EXPECT_EQ(buffer.read(), 9);
+}
+
+TEST(TripleBufferTest, ReaderSeesWholeSnapshotsInOrder) {
+    constexpr uint64_t kPublishes = 200000;
+    TripleBuffer<Snapshot> buffer(Snapshot{});
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= kPublishes; ++i) {
+            for (uint64_t& value : buffer.write_buffer().values) {
+                value = i;
+            }
+            buffer.publish();
+        }
+        done = true;
+    });
+    int torn = 0;
+    uint64_t last = 0;
+    for (;;) {
+        bool finished = done.load();
+        if (buffer.update()) {
+            const Snapshot& snapshot = buffer.read_buffer();
+            for (uint64_t value : snapshot.values) {
+                torn += value != snapshot.values[0];
+            }
+            torn += snapshot.values[0] <= last;
+            last = snapshot.values[0];
+        }
+        if (finished) {
+            break;
+        }
+    }
+    writer.join();
+    buffer.update();
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(buffer.read_buffer().values[0], kPublishes);
+}
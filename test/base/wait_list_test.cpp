@@ -0,0 +1,186 @@
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include <gtest/gtest.h>
+
+#include "mutex.hpp"
+#include "wait_list.hpp"
+
+using namespace cybertron::base;
+using namespace std::chrono_literals;
+
+namespace {
+// Spins until {count} waiters are parked in {list}, so tests can start them in a known order.
+template <typename Mutex, typename Condition>
+void await_parked(Mutex& mutex, const WaitList<Condition>& list, size_t count) {
+    for (;;) {
+        {
+            std::lock_guard<Mutex> lock(mutex);
+            if (list.size() == count) {
+                return;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+}  // namespace
+
+TEST(WaitListTest, NotifyWakesOnlyThatWaiter) {
+    std::mutex mutex;
+    WaitList<std::condition_variable> list;
+    WaitList<std::condition_variable>::Waiter targets[3];
+    int checks[3] = {0, 0, 0};
+    bool released[3] = {false, false, false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([&, i] {
+            std::unique_lock<std::mutex> lock(mutex);
+            list.wait_until(lock, targets[i], std::chrono::steady_clock::time_point::max(), [&] {
+                ++checks[i];
+                return released[i];
+            });
+        });
+    }
+    await_parked(mutex, list, 3);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released[1] = true;
+        list.notify(targets[1]);
+    }
+    threads[1].join();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Each of the others checked once before parking and was never woken since.
+        EXPECT_EQ(list.size(), 2u);
+        EXPECT_EQ(checks[0], 1);
+        EXPECT_EQ(checks[2], 1);
+        released[0] = released[2] = true;
+        list.notify_all();
+        EXPECT_TRUE(list.empty());
+    }
+    threads[0].join();
+    threads[2].join();
+}
+
+TEST(WaitListTest, NotifyOneIsFifo) {
+    std::mutex mutex;
+    WaitList<std::condition_variable> list;
+    std::vector<int> order;
+    int tickets = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([&, i] {
+            std::unique_lock<std::mutex> lock(mutex);
+            list.wait(lock, [&] { return tickets > 0; });
+            --tickets;
+            order.push_back(i);
+        });
+        await_parked(mutex, list, static_cast<size_t>(i + 1));
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++tickets;
+            list.notify_one();
+        }
+        // Let the woken waiter run before the next one is woken; otherwise they race for the mutex in any order.
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (order.size() > i) {
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(WaitListTest, TimedOutWaiterHandsItsNotificationOn) {
+    std::mutex mutex;
+    WaitList<std::condition_variable> list;
+    std::unique_lock<std::mutex> lock(mutex);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(list.wait_for(lock, 20ms, [] { return false; }));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(WaitListTest, PassOnReachesTheNextWaiter) {
+    std::mutex mutex;
+    WaitList<std::condition_variable> list;
+    WaitList<std::condition_variable>::Waiter first;
+    bool ready = false;
+    bool second_done = false;
+    std::thread giving_up([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        list.wait_until(lock, first, std::chrono::steady_clock::time_point::max(), [&] { return ready; });
+        // Woken for a reason it no longer cares about: the wakeup goes to the next waiter.
+        list.pass_on(first);
+    });
+    await_parked(mutex, list, 1);
+    std::thread second([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        list.wait(lock, [&] { return ready; });
+        second_done = true;
+    });
+    await_parked(mutex, list, 2);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready = true;
+        list.notify_one();
+    }
+    giving_up.join();
+    second.join();
+    EXPECT_TRUE(second_done);
+}
+
+TEST(WaitListTest, ProducersAndConsumersNeverLoseAWakeup) {
+    constexpr int kItems = 50000;
+    Mutex mutex;
+    WaitList<ConditionVariable> not_empty;
+    WaitList<ConditionVariable> not_full;
+    int queued = 0;
+    int consumed = 0;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 2; ++p) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kItems / 2; ++i) {
+                std::unique_lock<Mutex> lock(mutex);
+                not_full.wait(lock, [&] { return queued < 4; });
+                ++queued;
+                not_empty.notify_one();
+            }
+        });
+    }
+    for (int c = 0; c < 3; ++c) {
+        threads.emplace_back([&] {
+            std::unique_lock<Mutex> lock(mutex);
+            for (;;) {
+                // Short timeouts make waiters leave now and then while being notified.
+                if (!not_empty.wait_for(lock, 100us, [&] { return queued > 0 || consumed == kItems; })) {
+                    continue;
+                }
+                if (consumed == kItems) {
+                    not_empty.notify_all();
+                    return;
+                }
+                --queued;
+                ++consumed;
+                not_full.notify_one();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(consumed, kItems);
+}